@@ -7,10 +7,38 @@
 #define ALGORITHMS_HPP
 
 #include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "Results.hpp"
+#include "ContractionHierarchy.hpp"
+#include <atomic>
 #include <climits>  // for INT_MAX
 
 namespace graph {
 
+namespace parallel {
+class RangePool;
+}
+
+// how stronglyConnectedComponents does its work
+enum class SccEngine {
+    Auto,               // ForwardBackward for large graphs with several threads
+    Tarjan,             // iterative Tarjan, one thread
+    ForwardBackward     // parallel trim and recursive forward-backward
+};
+
+// how coreNumbers does its work
+enum class CoreEngine {
+    Auto,               // ParallelPeel for large graphs with several threads
+    Bucket,             // Batagelj-Zaversnik, one thread
+    ParallelPeel        // level by level peeling on numThreads threads
+};
+
+// how buildLandmarks picks its landmarks
+enum class LandmarkSelection {
+    Farthest,   // each new landmark is the vertex farthest from the chosen ones
+    Avoid       // Goldberg-Werneck: grow into the region the bounds cover worst
+};
+
 class Algorithms {
 private:
     // for BFS
@@ -28,7 +56,27 @@ private:
         bool isEmpty() const;
     };
 
-    // for Dijkstra
+    // growable int array, e.g. per thread frontier buffers
+    struct Buffer {
+        int* data;
+        int size;
+        int capacity;
+
+        Buffer(int cap = 16);
+        ~Buffer();
+        void push(int x);
+        void clear() { size = 0; }
+    };
+
+    // one level of the explicit DFS stack
+    struct DfsFrame {
+        int vertex;
+        int next;           // index of the next neighbor to look at
+    };
+
+    // for Dijkstra and Prim
+    // indexed d-ary min-heap over vertices 0..cap-1, every vertex is in the
+    // heap at most once and position[] finds it for decreaseKey
     struct PriorityQueue {
         struct Item {
             int vertex;
@@ -37,15 +85,60 @@ private:
             Item(int v, int p) : vertex(v), priority(p) {}
         };
         Item* heap;
+        int* position;      // heap slot of each vertex, -1 if not queued
         int size;
         int capacity;
+        int arity;          // children per node
 
-        PriorityQueue(int cap);
+        PriorityQueue(int cap, int d = 4);
         ~PriorityQueue();
-        void insert(int vertex, int priority);
+        void insert(int vertex, int priority);     // or lower it if queued
         int extractMin();
         void decreaseKey(int vertex, int newPriority);
+        bool contains(int vertex) const;
         bool isEmpty() const;
+        int minPriority() const { return heap[0].priority; }
+        void clear();
+
+        void siftUp(int i);
+        void siftDown(int i);
+    };
+
+    // for Dial's Dijkstra: ring of maxWeight + 1 buckets, each an intrusive
+    // doubly linked list, so insert / decreaseKey / extractMin are O(1)
+    struct BucketQueue {
+        int* head;          // first vertex of each bucket, -1 if empty
+        int* next;
+        int* prev;
+        int* slot;          // bucket of each vertex, -1 if not queued
+        int buckets;
+        int size;
+        long long cursor;   // smallest key that can still be queued
+
+        BucketQueue(int cap, int maxKeyStep);
+        ~BucketQueue();
+        void insert(int vertex, long long key);
+        void decreaseKey(int vertex, long long newKey);
+        int extractMin();
+        bool isEmpty() const { return size == 0; }
+
+        void unlink(int vertex);
+    };
+
+    // largest weight for which dijkstra() switches to buckets
+    static const int DIAL_MAX_WEIGHT = 4096;
+
+    // adjacency that changes while a contraction hierarchy is built
+    struct ContractionGraph {
+        ChArc** lists;
+        int* sizes;
+        int* capacities;
+        int numVertices;
+
+        ContractionGraph(int n);
+        ~ContractionGraph();
+        void addOrLower(int u, int v, int weight, int middle);  // arc u -> v
+        void remove(int u, int v);                              // arc u -> v
     };
 
     // for Kruskal
@@ -57,15 +150,298 @@ private:
         UnionFind(int n);
         ~UnionFind();
         int find(int x);
+        int findRoot(int x) const;      // no compression, safe for parallel readers
         void unite(int x, int y);
     };
 
+    // union-find many threads can share: roots are linked by CAS, always
+    // under the smaller index, and find shortens paths by splitting
+    struct ConcurrentUnionFind {
+        std::atomic<int>* parent;
+        int size;
+
+        ConcurrentUnionFind(int n);
+        ~ConcurrentUnionFind();
+        int find(int x);
+        bool unite(int x, int y);       // true for the call that merged the sets
+        bool sameSet(int x, int y);
+    };
+
+    // for Louvain
+    // open addressing map community -> summed weight, one per thread, cleared
+    // through the list of used slots
+    struct WeightTable {
+        int* keys;              // -1 for an empty slot
+        long long* values;
+        int* used;              // occupied slots in insertion order
+        int usedCount;
+        int capacity;           // power of two, at most half full
+
+        WeightTable(int cap = 16);
+        ~WeightTable();
+        void add(int key, long long weight);
+        long long get(int key) const;
+        void clear();
+        void grow();
+    };
+
+    // one Louvain level: symmetric arcs with 64-bit weights, a community of
+    // the level below becomes one vertex with a self loop for its inside
+    struct LevelGraph {
+        int numVertices;
+        int* offsets;
+        int* targets;
+        long long* weights;
+
+        LevelGraph(int vertices, int* offs, int* list, long long* w);
+        ~LevelGraph();
+    };
+
+    // edge list of g (each undirected edge once), returns the edge count
+    template <typename G> static int collectEdges(const G& g, Edge*& edges);
+    // stable radix sort by weight, parallel on large arrays
+    static void sortEdges(Edge* edges, int count, int numThreads);
+    // stable split of edges by keep(edge), kept ones first, returns their count
+    template <typename Keep>
+    static int partitionEdges(Edge* edges, Edge* scratch, int count, int threads, Keep keep);
+    static void filterKruskalStep(Edge* edges, Edge* scratch, int count, int threads,
+                                  UnionFind& uf, SpanningForest& result);
+
+    // level by level sweep: expand(u, out) pushes the next level of queue[],
+    // levels are split over threads. Returns how many vertices were queued.
+    template <typename Expand>
+    static int sweepFrontier(int* queue, int size, int threads, Expand expand);
+
+    // strongly connected components, label = a representative vertex
+    // Tarjan over the vertices still labeled -1, arcs to labeled ones are ignored
+    static void tarjanScc(const CsrGraph& g, int* label);
+    // Tarjan from roots[0..rootCount) (0..rootCount-1 if roots is null) over
+    // the vertices inside(w) accepts, assign(w, root) labels a component and
+    // must make inside(w) false. index[] is -1 for every such vertex on entry.
+    template <typename Inside, typename Assign>
+    static void tarjanRun(const CsrGraph& g, const int* roots, int rootCount, Inside inside, Assign assign,
+                          int* index, int* low, DfsFrame* frames, Buffer& stack);
+    // per thread arrays of the recursive forward-backward tasks, index all -1
+    // and mark all 0 between tasks
+    struct SccScratch {
+        int* index;
+        int* low;
+        int* degree;
+        int* queue;
+        DfsFrame* frames;
+        char* mark;
+        Buffer stack;
+
+        explicit SccScratch(int vertices);
+        ~SccScratch();
+    };
+    // one subproblem: the vertices order[lo, hi), all of one color. Trims it,
+    // splits off the pivot's component and pushes the three remainders with
+    // fresh colors; small ones go to Tarjan instead.
+    static void sccTask(const CsrGraph& g, const CsrGraph& incoming, int* order, int lo, int hi,
+                        std::atomic<int>* color, std::atomic<int>& nextColor, std::atomic<int>* label,
+                        SccScratch& scratch, parallel::RangePool& pool);
+    // peels vertices without unlabeled in- or out-neighbors
+    static void trimScc(const CsrGraph& g, const CsrGraph& incoming, std::atomic<int>* label, int threads);
+    // marks (with bit) every unlabeled vertex reachable from source over g's arcs
+    static void reachUnlabeled(const CsrGraph& g, int source, const std::atomic<int>* label,
+                               std::atomic<char>* mark, char bit, int* queue, int threads);
+    // labels become 0..k-1 by smallest vertex, then the condensation is built
+    static void finishScc(const CsrGraph& g, SccResult& result);
+
+    // twin[a] = index of the reverse arc of arc a, -1 if there is none
+    static void twinArcs(const CsrGraph& g, int* twin);
+
+    // shared bodies, G is Graph or CsrGraph
+    template <typename G> static TraversalResult bfsImpl(const G& g, int source);
+    template <typename G> static DfsResult dfsImpl(const G& g, int source);
+    template <typename G> static DfsResult dfsForestImpl(const G& g);
+    template <typename G>
+    static void dfsVisit(const G& g, int root, DfsResult& result, DfsFrame* stack, int& clock, int& finished);
+    template <typename G> static ShortestPathResult dijkstraImpl(const G& g, int source);
+    template <typename G> static ShortestPathResult heapDijkstraImpl(const G& g, int source);
+    template <typename G> static ShortestPathResult dialImpl(const G& g, int source, int maxWeight);
+    template <typename G> static ShortestPathResult dialAuto(const G& g, int source);
+
+    // A* core, the heuristic comes in as a plain function pointer + context
+    static PathResult aStarSearch(const CsrGraph& g, int source, int target,
+                                  int (*heuristic)(void* context, int vertex), void* context);
+    template <typename H> static int callHeuristic(void* context, int vertex) {
+        return (*static_cast<H*>(context))(vertex);
+    }
+    template <typename G> static SpanningForest primImpl(const G& g);
+    template <typename G> static SpanningForest kruskalImpl(const G& g);
+    template <typename G> static void coreBucketImpl(const G& g, CoreResult& result);
+    // Louvain steps: local moves on one level (true if any vertex moved),
+    // and the next level with one vertex per community of comm (0..k-1)
+    static bool louvainMoves(const LevelGraph& h, int* comm, int threads, double tolerance);
+    static LevelGraph* louvainAggregate(const LevelGraph& h, const int* comm, int k, int threads);
+    template <typename G>
+    static void pprImpl(const G& g, int seed, PprWorkspace& ws, double alpha, double epsilon);
+
 public:
-    static Graph bfs(const Graph& g, int source);
-    static Graph dfs(const Graph& g, int source);
-    static Graph dijkstra(const Graph& g, int source);
-    static Graph prim(const Graph& g);
-    static Graph kruskal(const Graph& g);
+    // results are flat arrays, call toGraph() on them for the old tree Graphs
+    static TraversalResult bfs(const Graph& g, int source);
+    static DfsResult dfs(const Graph& g, int source);
+    static ShortestPathResult dijkstra(const Graph& g, int source);
+    static SpanningForest prim(const Graph& g);
+    static SpanningForest kruskal(const Graph& g);
+
+    // same algorithms over a frozen snapshot (see Graph::freeze)
+    static TraversalResult bfs(const CsrGraph& g, int source);
+    static DfsResult dfs(const CsrGraph& g, int source);
+    static ShortestPathResult dijkstra(const CsrGraph& g, int source);
+    static SpanningForest prim(const CsrGraph& g);
+    static SpanningForest kruskal(const CsrGraph& g);
+
+    // Dijkstra on a bucket queue (Dial), O(V + E + max distance). dijkstra()
+    // picks it by itself when all weights are in 0..DIAL_MAX_WEIGHT.
+    static ShortestPathResult dial(const Graph& g, int source);
+    static ShortestPathResult dial(const CsrGraph& g, int source);
+
+    // Dijkstra on the indexed heap whatever the weights, what dijkstra() runs
+    // when they fall outside Dial's range
+    static ShortestPathResult dijkstraHeap(const Graph& g, int source);
+    static ShortestPathResult dijkstraHeap(const CsrGraph& g, int source);
+
+    // point to point distance and path with bidirectional Dijkstra. The
+    // backward search walks reverse (g.transpose() for directed graphs),
+    // the overloads without it treat g as undirected. Weights must be >= 0.
+    static PathResult shortestPath(const CsrGraph& g, const CsrGraph& reverse, int source, int target);
+    static PathResult shortestPath(const CsrGraph& g, int source, int target);
+    static PathResult shortestPath(const Graph& g, int source, int target);
+
+    // A* from source to target. heuristic(v) must never overestimate the
+    // distance from v to target, any callable int(int) works.
+    template <typename H>
+    static PathResult aStar(const CsrGraph& g, int source, int target, H heuristic) {
+        return aStarSearch(g, source, target, &callHeuristic<H>, &heuristic);
+    }
+
+    // ALT: landmark distance tables once, then A* with triangle inequality
+    // bounds for every query. Undirected graphs, weights >= 0.
+    static LandmarkIndex buildLandmarks(const CsrGraph& g, int count,
+                                        LandmarkSelection selection = LandmarkSelection::Farthest);
+    static PathResult altShortestPath(const CsrGraph& g, const LandmarkIndex& index, int source, int target);
+
+    // Contraction Hierarchies for many queries on a graph that rarely changes.
+    // Vertices are contracted in edge difference order, witness searches
+    // decide which shortcuts are needed. Undirected graphs, weights >= 0.
+    // Query with ChQuery (reusable) or chShortestPath (one off).
+    static ContractionHierarchy buildContractionHierarchy(const CsrGraph& g);
+    static ContractionHierarchy buildContractionHierarchy(const Graph& g);
+    static PathResult chShortestPath(const ContractionHierarchy& ch, int source, int target);
+
+    // Kruskal that sorts only the edges it might still need: split around a
+    // pivot weight, solve the light half, throw out heavy edges that already
+    // close a cycle, then recurse on the rest. Splits and filters are parallel.
+    static SpanningForest filterKruskal(const CsrGraph& g, int numThreads = 0);
+    static SpanningForest filterKruskal(const Graph& g, int numThreads = 0);
+
+    // minimum spanning forest with parallel Boruvka rounds
+    static SpanningForest boruvka(const CsrGraph& g, int numThreads = 0);
+    static SpanningForest boruvka(const Graph& g, int numThreads = 0);
+
+    // connected components on numThreads threads (Afforest). Edges are read
+    // as undirected, so a directed graph needs both arcs to be connected.
+    static ComponentLabels connectedComponents(const CsrGraph& g, int numThreads = 0);
+    static ComponentLabels connectedComponents(const Graph& g, int numThreads = 0);
+
+    // strongly connected components of a directed graph, numbered by their
+    // smallest vertex whichever engine runs, plus the condensation DAG
+    static SccResult stronglyConnectedComponents(const CsrGraph& g, SccEngine engine = SccEngine::Auto,
+                                                 int numThreads = 0);
+    static SccResult stronglyConnectedComponents(const Graph& g, SccEngine engine = SccEngine::Auto,
+                                                 int numThreads = 0);
+
+    // bridges, articulation points and biconnected components of an
+    // undirected graph in one iterative low-link DFS. Arc labels follow the
+    // arc order of g (of g.freeze() for a Graph).
+    static BiconnectivityResult biconnectivity(const CsrGraph& g);
+    static BiconnectivityResult biconnectivity(const Graph& g);
+
+    // PageRank by power iteration, pulling over incoming arcs (g.transpose()).
+    // Dangling vertices spread their rank evenly. Stops once the L1 change of
+    // an iteration is below tolerance or after maxIterations.
+    static PageRankResult pageRank(const CsrGraph& g, double damping = 0.85, double tolerance = 1e-6,
+                                   int maxIterations = 100, int numThreads = 0);
+    static PageRankResult pageRank(const Graph& g, double damping = 0.85, double tolerance = 1e-6,
+                                   int maxIterations = 100, int numThreads = 0);
+
+    // Brandes betweenness, sources spread over numThreads threads. Hop counts
+    // when every weight is the same, otherwise weighted (weights > 0). With
+    // samples > 0 only that many random sources run and the scores are
+    // scaled up, see BetweennessResult::errorBound. Pairs are ordered, so an
+    // undirected graph counts every pair twice.
+    static BetweennessResult betweenness(const CsrGraph& g, int samples = 0, int numThreads = 0,
+                                         unsigned seed = 12345u);
+    static BetweennessResult betweenness(const Graph& g, int samples = 0, int numThreads = 0,
+                                         unsigned seed = 12345u);
+
+    // triangle counts and clustering coefficients of an undirected graph
+    // (every edge stored in both directions, as Graph::addEdge does),
+    // vertices spread over numThreads threads
+    static TriangleResult countTriangles(const CsrGraph& g, int numThreads = 0);
+    static TriangleResult countTriangles(const Graph& g, int numThreads = 0);
+
+    // core number of every vertex of an undirected graph in O(V + E)
+    static CoreResult coreNumbers(const CsrGraph& g, CoreEngine engine = CoreEngine::Auto, int numThreads = 0);
+    static CoreResult coreNumbers(const Graph& g, CoreEngine engine = CoreEngine::Auto, int numThreads = 0);
+
+    // Louvain community detection on numThreads threads, edge weights are
+    // Neighbor::weight (>= 0). Arcs are made symmetric first, u and v are
+    // joined by w(u, v) + w(v, u), so directed input is fine and undirected
+    // graphs keep their modularity. A level stops once a sweep of local moves
+    // gains less than tolerance modularity.
+    static CommunityResult louvain(const CsrGraph& g, int numThreads = 0, double tolerance = 1e-6,
+                                   int maxLevels = 20);
+    static CommunityResult louvain(const Graph& g, int numThreads = 0, double tolerance = 1e-6,
+                                   int maxLevels = 20);
+
+    // personalized PageRank from one seed by local push (Andersen, Chung,
+    // Lang). Scores land in ws.estimate for the ws.touched vertices. They
+    // never overshoot, and on undirected graphs stay within epsilon * degree
+    // of the exact value. alpha is the chance to jump back to the seed, walks
+    // stuck in a dangling vertex jump back as well.
+    static void personalizedPageRank(const Graph& g, int seed, PprWorkspace& ws,
+                                     double alpha = 0.15, double epsilon = 1e-6);
+    static void personalizedPageRank(const CsrGraph& g, int seed, PprWorkspace& ws,
+                                     double alpha = 0.15, double epsilon = 1e-6);
+
+    // DFS from every undiscovered vertex in id order, covers the whole graph
+    static DfsResult dfsForest(const Graph& g);
+    static DfsResult dfsForest(const CsrGraph& g);
+
+    // BFS that switches between top-down and bottom-up steps. It goes
+    // bottom-up once the frontier's edges exceed 1/alpha of the unexplored
+    // ones, and back once the frontier shrinks below n/beta. Bottom-up reads
+    // incoming lists: g itself for undirected graphs, g.transpose() otherwise.
+    // The CsrGraph form without them needs an undirected g; the Graph form
+    // builds the transpose, so directed arcs are fine there.
+    static TraversalResult bfsDirectionOptimizing(const CsrGraph& g, const CsrGraph& incoming,
+                                                  int source, int alpha = 15, int beta = 18);
+    static TraversalResult bfsDirectionOptimizing(const CsrGraph& g, int source,
+                                                  int alpha = 15, int beta = 18);
+    static TraversalResult bfsDirectionOptimizing(const Graph& g, int source,
+                                                  int alpha = 15, int beta = 18);
+
+    // level synchronous BFS on numThreads threads (0 = all cores). Depths
+    // match bfs(), the parent may be any neighbor one level up.
+    static TraversalResult parallelBfs(const CsrGraph& g, int source, int numThreads = 0);
+    static TraversalResult parallelBfs(const Graph& g, int source, int numThreads = 0);
+
+    // hop distances from many sources, 64 BFS runs share every adjacency
+    // scan (one uint64_t of lanes, no wider SIMD variant). Batches of 64
+    // sources are spread over numThreads threads.
+    static MultiSourceDistances multiSourceBfs(const CsrGraph& g, const int* sources, int count,
+                                               int numThreads = 0);
+    static MultiSourceDistances multiSourceBfs(const Graph& g, const int* sources, int count,
+                                               int numThreads = 0);
+
+    // parallel single source shortest paths with buckets of width delta
+    // (0 = average edge weight). Same distances as dijkstra(), weights >= 0.
+    static ShortestPathResult deltaStepping(const CsrGraph& g, int source, int delta = 0, int numThreads = 0);
+    static ShortestPathResult deltaStepping(const Graph& g, int source, int delta = 0, int numThreads = 0);
 };
 
 } // namespace graph
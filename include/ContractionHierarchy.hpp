@@ -0,0 +1,110 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * ContractionHierarchy - preprocessed graph for fast shortest path queries
+ */
+
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "Results.hpp"
+
+namespace graph {
+
+// arc of the upward graph, middle is the contracted vertex a shortcut skips
+struct ChArc {
+    int vertex;     // higher ranked endpoint
+    int weight;     // edge weight
+    int middle;     // -1 for an original edge
+
+    ChArc(int v = 0, int w = 0, int m = -1) : vertex(v), weight(w), middle(m) {}
+};
+
+// Result of Algorithms::buildContractionHierarchy. Every vertex has a rank
+// (the order it was contracted in) and keeps the arcs, original or shortcut,
+// that lead to higher ranked vertices, stored as CSR. Graphs are undirected,
+// so the upward arcs read backwards are the downward graph and both query
+// searches run on this one array.
+class ContractionHierarchy {
+private:
+    int numVertices;        // number of vertices
+    int numArcs;            // number of upward arcs
+    int* rank;              // contraction order of each vertex
+    int* offsets;           // numVertices + 1 start positions
+    ChArc* arcs;            // upward arcs of all vertices, one after another
+
+    // checks a loaded file beyond its size: offsets, ranks and arc endpoints
+    static bool validLayout(int vertices, const int* ranks, const int* offs, const ChArc* list);
+
+public:
+    // adopts arrays made with new[]
+    ContractionHierarchy(int vertices, int* ranks, int* offs, ChArc* list);
+
+    // destructor
+    ~ContractionHierarchy();
+
+    // cant copy hierarchies
+    ContractionHierarchy(const ContractionHierarchy&) = delete;
+    ContractionHierarchy& operator=(const ContractionHierarchy&) = delete;
+
+    // can move hierarchies
+    ContractionHierarchy(ContractionHierarchy&& other) noexcept;
+    ContractionHierarchy& operator=(ContractionHierarchy&& other) noexcept;
+
+    // binary file, throws std::runtime_error on I/O errors or bad files
+    void save(const char* path) const;
+    static ContractionHierarchy load(const char* path);
+
+    // getters
+    int getNumVertices() const { return numVertices; }
+    int getNumArcs() const { return numArcs; }
+    int getRank(int vertex) const { return rank[vertex]; }
+    const ChArc* getUpArcs(int vertex) const { return arcs + offsets[vertex]; }
+    int getUpArcCount(int vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+
+    // the upward arc between a lower ranked vertex and a neighbor, or nullptr
+    const ChArc* findUpArc(int lower, int higher) const;
+};
+
+// Reusable query engine over one hierarchy. Both searches only climb to
+// higher ranks, and the scratch labels are reset through a touched list, so
+// a query costs only the vertices it reaches. Keep one per thread.
+class ChQuery {
+private:
+    struct HeapItem {
+        int key;
+        int vertex;
+    };
+
+    const ContractionHierarchy& ch;
+    int* dist[2];           // forward / backward labels, INT_MAX if untouched
+    int* parent[2];         // previous vertex of the label
+    int* middle[2];         // middle of the arc to the parent, -1 if original
+    int* touched;           // vertices with a label on either side
+    int touchedCount;
+    HeapItem* heap[2];      // binary heaps with lazy deletion, grow on demand
+    int heapSize[2];
+    int heapCapacity[2];
+    int* unpackStack;       // explicit stack for shortcut unpacking
+    int unpackCapacity;
+
+    void push(int side, int key, int vertex);
+    HeapItem pop(int side);
+    void label(int side, int vertex, int d, int from, int mid);
+    bool appendUnpacked(int from, int to, int mid, int* out, int& length);
+
+public:
+    explicit ChQuery(const ContractionHierarchy& hierarchy);
+    ~ChQuery();
+
+    // cant copy queries
+    ChQuery(const ChQuery&) = delete;
+    ChQuery& operator=(const ChQuery&) = delete;
+
+    // distance and fully unpacked path in the original graph, throws
+    // std::runtime_error if a shortcut cannot be unpacked
+    PathResult shortestPath(int source, int target);
+};
+
+} // namespace graph
+
+#endif // CONTRACTIONHIERARCHY_HPP
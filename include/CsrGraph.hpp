@@ -0,0 +1,65 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * CsrGraph - read-only compressed sparse row copy of a Graph
+ */
+
+#ifndef CSRGRAPH_HPP
+#define CSRGRAPH_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+// Immutable snapshot of a Graph. All neighbor lists live back to back in one
+// array and offsets[v] .. offsets[v+1] is the slice that belongs to vertex v,
+// so walking the graph is a sequential scan instead of one pointer chase per
+// vertex. Build it with Graph::freeze() once the graph stops changing.
+class CsrGraph {
+private:
+    int numVertices;        // number of vertices
+    int numArcs;            // number of stored (directed) neighbor entries
+    int* offsets;           // numVertices + 1 start positions
+    Neighbor* arcs;         // all neighbor lists, one after another
+    int minWeight;          // smallest arc weight, 0 without arcs
+    int maxWeight;          // largest arc weight, 0 without arcs
+
+    void findWeightRange();
+
+public:
+    // snapshot of a mutable graph
+    explicit CsrGraph(const Graph& g);
+
+    // adopts arrays made with new[], offs has vertices + 1 entries
+    CsrGraph(int vertices, int* offs, Neighbor* list);
+
+    // destructor
+    ~CsrGraph();
+
+    // cant copy graphs
+    CsrGraph(const CsrGraph&) = delete;
+    CsrGraph& operator=(const CsrGraph&) = delete;
+
+    // can move graphs
+    CsrGraph(CsrGraph&& other) noexcept;
+    CsrGraph& operator=(CsrGraph&& other) noexcept;
+
+    void print_graph() const;
+
+    // same vertices with every arc reversed (incoming lists)
+    CsrGraph transpose() const;
+
+    // getters (same shape as Graph so the algorithms work on both)
+    int getNumVertices() const { return numVertices; }
+    int getNumArcs() const { return numArcs; }
+    const Neighbor* getNeighbors(int vertex) const { return arcs + offsets[vertex]; }
+    int getNeighborCount(int vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+    const int* getOffsets() const { return offsets; }
+
+    // weight range, found once when the snapshot is built
+    int getMinWeight() const { return minWeight; }
+    int getMaxWeight() const { return maxWeight; }
+};
+
+} // namespace graph
+
+#endif // CSRGRAPH_HPP
@@ -6,6 +6,8 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include <atomic>
+
 namespace graph {
 
 // stores info about a neighbor
@@ -16,17 +18,27 @@ struct Neighbor {
     Neighbor(int v = 0, int w = 1) : vertex(v), weight(w) {}
 };
 
+class CsrGraph;
+
 class Graph {
 private:
     int numVertices;                    // number of vertices
     Neighbor** adjacencyList;           // array of adjacency lists
     int* listSizes;                     // size of each list
     int* listCapacities;                // capacity of each list
+    int numArcs;                        // stored (directed) neighbor entries
+    // weight range, 0 0 without arcs. Removing an arc only marks it stale and
+    // the next read rescans; concurrent readers may both rescan, so atomics.
+    mutable std::atomic<int> minWeight;
+    mutable std::atomic<int> maxWeight;
+    mutable std::atomic<bool> weightRangeStale;
 
     // helper functions
     void resizeList(int vertex, int newCapacity);
     bool hasEdge(int source, int dest) const;
     void removeFromList(int vertex, int neighbor);
+    void noteWeight(int weight);
+    void recomputeWeightRange() const;
 
 public:
     // constructor
@@ -48,11 +60,26 @@ public:
     void addDirectedEdge(int source, int dest, int weight = 1);
     void removeEdge(int source, int dest);
     void print_graph() const;
+
+    // read-only contiguous snapshot for traversal heavy work
+    CsrGraph freeze() const;
     
     // getters
     int getNumVertices() const { return numVertices; }
     const Neighbor* getNeighbors(int vertex) const { return adjacencyList[vertex]; }
     int getNeighborCount(int vertex) const { return listSizes[vertex]; }
+    int getNumArcs() const { return numArcs; }
+
+    // weight range kept up to date by every edit, so algorithms that pick a
+    // strategy by weights do not have to scan the graph on each call
+    int getMinWeight() const {
+        if (weightRangeStale.load(std::memory_order_acquire)) recomputeWeightRange();
+        return minWeight.load(std::memory_order_relaxed);
+    }
+    int getMaxWeight() const {
+        if (weightRangeStale.load(std::memory_order_acquire)) recomputeWeightRange();
+        return maxWeight.load(std::memory_order_relaxed);
+    }
 };
 
 } // namespace graph
@@ -0,0 +1,183 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * small helpers for running algorithm phases on several threads
+ */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace graph {
+namespace parallel {
+
+// number of threads to use, 0 means one per hardware thread
+inline int threadCount(int requested) {
+    if (requested > 0) return requested;
+    int hw = (int)std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// calls f(threadId) for threadId = 0..threads-1, the caller is thread 0
+template <typename F>
+void run(int threads, F f) {
+    if (threads <= 1) {
+        f(0);
+        return;
+    }
+    std::thread* workers = new std::thread[threads - 1];
+    for (int t = 1; t < threads; t++) {
+        workers[t - 1] = std::thread([&f, t]() { f(t); });
+    }
+    f(0);
+    for (int t = 1; t < threads; t++) {
+        workers[t - 1].join();
+    }
+    delete[] workers;
+}
+
+// all threads of a run() wait here until the last one arrives
+class Barrier {
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    int threads;
+    int waiting;
+    int generation;
+
+public:
+    explicit Barrier(int count) : threads(count), waiting(0), generation(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        int arrivedIn = generation;
+        if (++waiting == threads) {
+            waiting = 0;
+            generation++;
+            released.notify_all();
+        } else {
+            released.wait(lock, [&]() { return generation != arrivedIn; });
+        }
+    }
+};
+
+// Index range split into one slice per thread. Threads take chunks from their
+// own slice first and steal chunks from the other slices when it runs dry, so
+// uneven work (skewed degrees) still keeps every thread busy.
+class WorkStealingRange {
+private:
+    struct alignas(64) Slice {
+        std::atomic<int> next;
+        int end;
+    };
+    Slice* slices;
+    int threads;
+    int chunk;
+
+public:
+    WorkStealingRange(int count, int chunkSize) : threads(count), chunk(chunkSize) {
+        slices = new Slice[count];
+        reset(0, 0);
+    }
+    ~WorkStealingRange() { delete[] slices; }
+
+    WorkStealingRange(const WorkStealingRange&) = delete;
+    WorkStealingRange& operator=(const WorkStealingRange&) = delete;
+
+    // not thread safe, call it while the workers are parked at a barrier
+    void reset(int begin, int end) {
+        long long length = end - begin;
+        for (int t = 0; t < threads; t++) {
+            slices[t].next.store(begin + (int)(length * t / threads), std::memory_order_relaxed);
+            slices[t].end = begin + (int)(length * (t + 1) / threads);
+        }
+    }
+
+    // next chunk [lo, hi) for thread t, false once everything is taken
+    bool next(int t, int& lo, int& hi) {
+        for (int k = 0; k < threads; k++) {
+            Slice& slice = slices[(t + k) % threads];
+            if (slice.next.load(std::memory_order_relaxed) >= slice.end) continue;
+            int start = slice.next.fetch_add(chunk, std::memory_order_relaxed);
+            if (start < slice.end) {
+                lo = start;
+                hi = start + chunk < slice.end ? start + chunk : slice.end;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Shared stack of [lo, hi) ranges for recursive work: a task may push the
+// pieces it splits into. pop() waits while other tasks still run and returns
+// false once the stack is empty and nobody is left to refill it. Every range
+// that pop() hands out must be closed with done(). Ranges are pushed at most
+// capacity at a time.
+class RangePool {
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    int* los;
+    int* his;
+    int size;
+    int running;
+
+public:
+    explicit RangePool(int capacity) : size(0), running(0) {
+        los = new int[capacity > 0 ? capacity : 1];
+        his = new int[capacity > 0 ? capacity : 1];
+    }
+    ~RangePool() {
+        delete[] los;
+        delete[] his;
+    }
+
+    RangePool(const RangePool&) = delete;
+    RangePool& operator=(const RangePool&) = delete;
+
+    void push(int lo, int hi) {
+        std::lock_guard<std::mutex> lock(mutex);
+        los[size] = lo;
+        his[size] = hi;
+        size++;
+        changed.notify_one();
+    }
+
+    bool pop(int& lo, int& hi) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return size > 0 || running == 0; });
+        if (size == 0) return false;
+        size--;
+        lo = los[size];
+        hi = his[size];
+        running++;
+        return true;
+    }
+
+    void done() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0 && size == 0) changed.notify_all();
+    }
+};
+
+// calls f(threadId, i) for every i in [begin, end) with work stealing
+template <typename F>
+void forEach(int begin, int end, int threads, int chunk, F f) {
+    WorkStealingRange range(threads, chunk);
+    range.reset(begin, end);
+    run(threads, [&](int t) {
+        int lo, hi;
+        while (range.next(t, lo, hi)) {
+            for (int i = lo; i < hi; i++) f(t, i);
+        }
+    });
+}
+
+} // namespace parallel
+} // namespace graph
+
+#endif // PARALLEL_HPP
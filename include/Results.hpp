@@ -0,0 +1,362 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * flat result types returned by the algorithms
+ */
+
+#ifndef RESULTS_HPP
+#define RESULTS_HPP
+
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+
+namespace graph {
+
+// one undirected weighted edge
+struct Edge {
+    int u, v, weight;
+};
+
+// what bfs and dfs found: visit order plus the search tree as parent links
+struct TraversalResult {
+    int numVertices;
+    int* order;             // reached vertices in visit order
+    int orderSize;          // how many vertices were reached
+    int* parent;            // tree parent, -1 for roots and unreached vertices
+    int* depth;             // tree edges from the root, -1 if unreached
+    int* parentWeight;      // weight of the edge to the parent
+
+    explicit TraversalResult(int vertices);
+    ~TraversalResult();
+
+    // cant copy results
+    TraversalResult(const TraversalResult&) = delete;
+    TraversalResult& operator=(const TraversalResult&) = delete;
+
+    // can move results
+    TraversalResult(TraversalResult&& other) noexcept;
+    TraversalResult& operator=(TraversalResult&& other) noexcept;
+
+    bool reached(int vertex) const { return depth[vertex] != -1; }
+
+    // search tree as a Graph with directed parent -> child edges
+    Graph toGraph() const;
+};
+
+// depth first search with timestamps, order holds the pre-order
+struct DfsResult : TraversalResult {
+    int* discovery;         // clock value when first reached, -1 if unreached
+    int* finish;            // clock value when its subtree was done, -1 if unreached
+    int* postOrder;         // reached vertices in finishing order (orderSize entries)
+
+    explicit DfsResult(int vertices);
+    ~DfsResult();
+
+    // can move results
+    DfsResult(DfsResult&& other) noexcept;
+    DfsResult& operator=(DfsResult&& other) noexcept;
+
+    const int* preOrder() const { return order; }
+};
+
+// hop distances from many sources at once
+struct MultiSourceDistances {
+    int numSources;
+    int numVertices;
+    int* dist;              // dist[i * numVertices + v], -1 if unreachable
+
+    MultiSourceDistances(int sources, int vertices);
+    ~MultiSourceDistances();
+
+    // cant copy results
+    MultiSourceDistances(const MultiSourceDistances&) = delete;
+    MultiSourceDistances& operator=(const MultiSourceDistances&) = delete;
+
+    // can move results
+    MultiSourceDistances(MultiSourceDistances&& other) noexcept;
+    MultiSourceDistances& operator=(MultiSourceDistances&& other) noexcept;
+
+    // distances from the i-th source
+    const int* row(int i) const { return dist + (long long)i * numVertices; }
+};
+
+// distances and shortest path tree from one source
+struct ShortestPathResult {
+    int numVertices;
+    int source;
+    int* dist;              // INT_MAX if unreachable
+    int* parent;            // previous vertex on a shortest path, -1 if none
+
+    ShortestPathResult(int vertices, int src);
+    ~ShortestPathResult();
+
+    // cant copy results
+    ShortestPathResult(const ShortestPathResult&) = delete;
+    ShortestPathResult& operator=(const ShortestPathResult&) = delete;
+
+    // can move results
+    ShortestPathResult(ShortestPathResult&& other) noexcept;
+    ShortestPathResult& operator=(ShortestPathResult&& other) noexcept;
+
+    bool reached(int vertex) const;
+
+    // number of vertices on the path source..target, 0 if unreachable
+    int pathLength(int target) const;
+    // writes the path source..target into out (pathLength entries)
+    int pathTo(int target, int* out) const;
+
+    // shortest path tree as a Graph with directed parent -> child edges
+    Graph toGraph() const;
+};
+
+// one source -> target shortest path
+struct PathResult {
+    int distance;           // INT_MAX if the target is unreachable
+    int* path;              // source .. target, length entries
+    int length;             // 0 if unreachable
+    int settled;            // vertices the search settled, a measure of work
+
+    PathResult();
+    ~PathResult();
+
+    // cant copy results
+    PathResult(const PathResult&) = delete;
+    PathResult& operator=(const PathResult&) = delete;
+
+    // can move results
+    PathResult(PathResult&& other) noexcept;
+    PathResult& operator=(PathResult&& other) noexcept;
+
+    bool found() const { return length > 0; }
+};
+
+// ALT preprocessing: exact distances from a few landmark vertices
+struct LandmarkIndex {
+    int numVertices;
+    int numLandmarks;
+    int* landmarks;         // the chosen vertices
+    int* dist;              // dist[l * numVertices + v], INT_MAX if unreachable
+
+    LandmarkIndex(int vertices, int count);
+    ~LandmarkIndex();
+
+    // cant copy results
+    LandmarkIndex(const LandmarkIndex&) = delete;
+    LandmarkIndex& operator=(const LandmarkIndex&) = delete;
+
+    // can move results
+    LandmarkIndex(LandmarkIndex&& other) noexcept;
+    LandmarkIndex& operator=(LandmarkIndex&& other) noexcept;
+
+    // triangle inequality lower bound on dist(v, target), undirected graphs
+    int lowerBound(int v, int target) const;
+};
+
+// edges picked by a minimum spanning tree / forest algorithm
+struct SpanningForest {
+    int numVertices;
+    Edge* edges;            // at most numVertices - 1 edges
+    int edgeCount;
+    long long totalWeight;
+
+    explicit SpanningForest(int vertices);
+    ~SpanningForest();
+
+    // cant copy results
+    SpanningForest(const SpanningForest&) = delete;
+    SpanningForest& operator=(const SpanningForest&) = delete;
+
+    // can move results
+    SpanningForest(SpanningForest&& other) noexcept;
+    SpanningForest& operator=(SpanningForest&& other) noexcept;
+
+    void add(int u, int v, int weight);
+
+    // forest as an undirected Graph
+    Graph toGraph() const;
+};
+
+// connected component of every vertex
+struct ComponentLabels {
+    int numVertices;
+    int* component;         // 0..numComponents-1, numbered by smallest vertex
+    int numComponents;
+
+    explicit ComponentLabels(int vertices);
+    ~ComponentLabels();
+
+    // cant copy results
+    ComponentLabels(const ComponentLabels&) = delete;
+    ComponentLabels& operator=(const ComponentLabels&) = delete;
+
+    // can move results
+    ComponentLabels(ComponentLabels&& other) noexcept;
+    ComponentLabels& operator=(ComponentLabels&& other) noexcept;
+
+    bool connected(int u, int v) const { return component[u] == component[v]; }
+};
+
+// strongly connected components plus the DAG between them
+struct SccResult : ComponentLabels {
+    CsrGraph condensation;  // one vertex per component, arc c -> d with the
+                            // lightest weight of any arc from c into d
+
+    explicit SccResult(int vertices);
+
+    // can move results
+    SccResult(SccResult&& other) noexcept;
+    SccResult& operator=(SccResult&& other) noexcept;
+};
+
+// single points of failure of an undirected graph
+struct BiconnectivityResult {
+    int numVertices;
+    int numArcs;
+    bool* articulation;     // removing the vertex splits its connected component
+    int* arcComponent;      // biconnected component of every arc, indexed like the
+                            // CsrGraph arc array, both directions of an edge agree,
+                            // -1 for self loops
+    int numComponents;
+    Edge* bridges;          // edges whose removal splits their connected component
+    int bridgeCount;
+
+    BiconnectivityResult(int vertices, int arcs);
+    ~BiconnectivityResult();
+
+    // cant copy results
+    BiconnectivityResult(const BiconnectivityResult&) = delete;
+    BiconnectivityResult& operator=(const BiconnectivityResult&) = delete;
+
+    // can move results
+    BiconnectivityResult(BiconnectivityResult&& other) noexcept;
+    BiconnectivityResult& operator=(BiconnectivityResult&& other) noexcept;
+};
+
+// PageRank scores and how the power iteration went
+struct PageRankResult {
+    int numVertices;
+    double* rank;               // sums to 1
+    int iterations;             // power iterations that ran
+    double residual;            // L1 change in the last iteration
+    bool converged;             // residual fell below the tolerance
+    double* iterationSeconds;   // wall time of every iteration
+
+    PageRankResult(int vertices, int maxIterations);
+    ~PageRankResult();
+
+    // cant copy results
+    PageRankResult(const PageRankResult&) = delete;
+    PageRankResult& operator=(const PageRankResult&) = delete;
+
+    // can move results
+    PageRankResult(PageRankResult&& other) noexcept;
+    PageRankResult& operator=(PageRankResult&& other) noexcept;
+};
+
+// betweenness centrality of every vertex
+struct BetweennessResult {
+    int numVertices;
+    double* score;          // over ordered pairs (s, t), the share of shortest
+                            // s-t paths passing through the vertex
+    int sourcesUsed;        // all vertices, or the size of the sample
+    double errorBound;      // 0 when exact, else every |score - exact| stays
+                            // below it with 95% probability (Hoeffding)
+
+    explicit BetweennessResult(int vertices);
+    ~BetweennessResult();
+
+    // cant copy results
+    BetweennessResult(const BetweennessResult&) = delete;
+    BetweennessResult& operator=(const BetweennessResult&) = delete;
+
+    // can move results
+    BetweennessResult(BetweennessResult&& other) noexcept;
+    BetweennessResult& operator=(BetweennessResult&& other) noexcept;
+};
+
+// triangles of an undirected graph
+struct TriangleResult {
+    int numVertices;
+    long long total;        // every triangle once
+    long long* perVertex;   // triangles through each vertex
+    double* clustering;     // local clustering coefficient, 0 below degree 2
+
+    explicit TriangleResult(int vertices);
+    ~TriangleResult();
+
+    // cant copy results
+    TriangleResult(const TriangleResult&) = delete;
+    TriangleResult& operator=(const TriangleResult&) = delete;
+
+    // can move results
+    TriangleResult(TriangleResult&& other) noexcept;
+    TriangleResult& operator=(TriangleResult&& other) noexcept;
+};
+
+// k-core decomposition
+struct CoreResult {
+    int numVertices;
+    int* core;              // largest k such that the vertex is in the k-core
+    int maxCore;            // degeneracy of the graph
+
+    explicit CoreResult(int vertices);
+    ~CoreResult();
+
+    // cant copy results
+    CoreResult(const CoreResult&) = delete;
+    CoreResult& operator=(const CoreResult&) = delete;
+
+    // can move results
+    CoreResult(CoreResult&& other) noexcept;
+    CoreResult& operator=(CoreResult&& other) noexcept;
+};
+
+// communities found by Louvain
+struct CommunityResult {
+    int numVertices;
+    int* community;         // 0..numCommunities-1
+    int numCommunities;
+    double modularity;      // of this partition on the input graph
+    int levels;             // local move + aggregation rounds that changed something
+
+    explicit CommunityResult(int vertices);
+    ~CommunityResult();
+
+    // cant copy results
+    CommunityResult(const CommunityResult&) = delete;
+    CommunityResult& operator=(const CommunityResult&) = delete;
+
+    // can move results
+    CommunityResult(CommunityResult&& other) noexcept;
+    CommunityResult& operator=(CommunityResult&& other) noexcept;
+};
+
+// Scores of the last personalizedPageRank call plus its scratch space. Only
+// the touched entries are reset between calls, so one workspace serves many
+// queries at a cost that depends on the neighborhood, not on the graph.
+struct PprWorkspace {
+    int numVertices;
+    double* estimate;       // approximate PPR score, 0 for untouched vertices
+    double* residual;       // mass not pushed yet
+    int* touched;           // vertices with a nonzero estimate or residual
+    int touchedCount;
+    int* queue;             // ring of vertices whose residual is over the threshold
+    bool* queued;
+
+    explicit PprWorkspace(int vertices);
+    ~PprWorkspace();
+
+    // cant copy workspaces
+    PprWorkspace(const PprWorkspace&) = delete;
+    PprWorkspace& operator=(const PprWorkspace&) = delete;
+
+    // can move workspaces
+    PprWorkspace(PprWorkspace&& other) noexcept;
+    PprWorkspace& operator=(PprWorkspace&& other) noexcept;
+
+    // zero the touched entries
+    void clear();
+};
+
+} // namespace graph
+
+#endif // RESULTS_HPP
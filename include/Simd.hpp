@@ -0,0 +1,188 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * vector kernels picked at run time, with plain loops as fallback
+ */
+
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GRAPH_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define GRAPH_SIMD_X86 0
+#endif
+
+namespace graph {
+namespace simd {
+
+// true if this cpu can run the AVX2 versions
+inline bool hasAvx2() {
+#if GRAPH_SIMD_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// out[i] = x[i] * scale[i], returns the sum of x[i] * mask[i]
+inline double scaleMaskedScalar(const double* x, const double* scale, const double* mask,
+                                double* out, int count) {
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        out[i] = x[i] * scale[i];
+        sum += x[i] * mask[i];
+    }
+    return sum;
+}
+
+// sum of |a[i] - b[i]|
+inline double l1DistanceScalar(const double* a, const double* b, int count) {
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        double d = a[i] - b[i];
+        sum += d < 0 ? -d : d;
+    }
+    return sum;
+}
+
+#if GRAPH_SIMD_X86
+__attribute__((target("avx2")))
+inline double horizontalSum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    low = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+__attribute__((target("avx2")))
+inline double scaleMaskedAvx2(const double* x, const double* scale, const double* mask,
+                              double* out, int count) {
+    __m256d sum = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(v, _mm256_loadu_pd(scale + i)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(v, _mm256_loadu_pd(mask + i)));
+    }
+    return horizontalSum(sum) + scaleMaskedScalar(x + i, scale + i, mask + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline double l1DistanceAvx2(const double* a, const double* b, int count) {
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    __m256d sum = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        sum = _mm256_add_pd(sum, _mm256_andnot_pd(signBit, d));
+    }
+    return horizontalSum(sum) + l1DistanceScalar(a + i, b + i, count - i);
+}
+#endif
+
+// calls match(x) for every x in both strictly increasing lists
+template <typename F>
+inline void intersectScalar(const int* a, int na, const int* b, int nb, F match) {
+    int i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) i++;
+        else if (a[i] > b[j]) j++;
+        else {
+            match(a[i]);
+            i++;
+            j++;
+        }
+    }
+}
+
+// one sweep over the long list, exponential then binary search for every
+// element of the short one, for lists of very different lengths
+template <typename F>
+inline void intersectGalloping(const int* small, int ns, const int* large, int nl, F match) {
+    int lo = 0;
+    for (int i = 0; i < ns && lo < nl; i++) {
+        int x = small[i];
+        int hi = lo;
+        int step = 1;
+        while (hi < nl && large[hi] < x) {
+            lo = hi + 1;
+            hi = lo + step;
+            step *= 2;
+        }
+        // first element >= x lies in [lo, hi]
+        int end = hi < nl ? hi + 1 : nl;
+        while (lo < end) {
+            int mid = lo + (end - lo) / 2;
+            if (large[mid] < x) lo = mid + 1;
+            else end = mid;
+        }
+        if (lo < nl && large[lo] == x) match(x);
+    }
+}
+
+#if defined(__SSE2__)
+// 4x4 blocks: every element of a block of a is compared with all four
+// rotations of a block of b, then the block with the smaller last element
+// moves on. SSE2 is part of every x86-64 cpu, so there is no dispatch.
+template <typename F>
+inline void intersectSse2(const int* a, int na, const int* b, int nb, F match) {
+    int i = 0, j = 0;
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        // lists are strictly increasing, so a hit is never seen twice
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        for (int k = 0; k < 4; k++) {
+            if ((mask >> k) & 1) match(a[i + k]);
+        }
+        int lastA = a[i + 3];
+        int lastB = b[j + 3];
+        if (lastA <= lastB) i += 4;
+        if (lastB <= lastA) j += 4;
+    }
+    intersectScalar(a + i, na - i, b + j, nb - j, match);
+}
+#endif
+
+// galloping when one list is over 32 times longer, else the vector merge
+template <typename F>
+inline void intersect(const int* a, int na, const int* b, int nb, F match) {
+    if (na * 32LL < nb) {
+        intersectGalloping(a, na, b, nb, match);
+        return;
+    }
+    if (nb * 32LL < na) {
+        intersectGalloping(b, nb, a, na, match);
+        return;
+    }
+#if defined(__SSE2__)
+    intersectSse2(a, na, b, nb, match);
+#else
+    intersectScalar(a, na, b, nb, match);
+#endif
+}
+
+inline double scaleMasked(const double* x, const double* scale, const double* mask, double* out, int count) {
+#if GRAPH_SIMD_X86
+    if (hasAvx2()) return scaleMaskedAvx2(x, scale, mask, out, count);
+#endif
+    return scaleMaskedScalar(x, scale, mask, out, count);
+}
+
+inline double l1Distance(const double* a, const double* b, int count) {
+#if GRAPH_SIMD_X86
+    if (hasAvx2()) return l1DistanceAvx2(a, b, count);
+#endif
+    return l1DistanceScalar(a, b, count);
+}
+
+} // namespace simd
+} // namespace graph
+
+#endif // SIMD_HPP
@@ -4,8 +4,14 @@
  */
 
 #include "../include/Algorithms.hpp"
+#include "../include/Parallel.hpp"
+#include "../include/Simd.hpp"
 #include <iostream>
+#include <atomic>
+#include <chrono>
 #include <climits>  // For INT_MAX
+#include <cmath>
+#include <cstdint>
 
 namespace graph {
 
@@ -41,29 +47,90 @@ bool Algorithms::Queue::isEmpty() const {
     return size == 0;
 }
 
+// Buffer implementation
+Algorithms::Buffer::Buffer(int cap) : size(0), capacity(cap > 0 ? cap : 1) {
+    data = new int[capacity];
+}
+
+Algorithms::Buffer::~Buffer() {
+    delete[] data;
+}
+
+void Algorithms::Buffer::push(int x) {
+    if (size == capacity) {
+        int* bigger = new int[capacity * 2];
+        for (int i = 0; i < size; i++) {
+            bigger[i] = data[i];
+        }
+        delete[] data;
+        data = bigger;
+        capacity *= 2;
+    }
+    data[size++] = x;
+}
+
 // PriorityQueue implementation
-Algorithms::PriorityQueue::PriorityQueue(int cap) : size(0), capacity(cap) {
+Algorithms::PriorityQueue::PriorityQueue(int cap, int d) : size(0), capacity(cap), arity(d) {
+    if (d < 2) {
+        throw std::invalid_argument("Heap arity must be at least 2");
+    }
     heap = new Item[cap];
-    for(int i = 0; i < cap; i++) {
-        heap[i] = Item(-1, INT_MAX);  // Initialize with dummy values
+    position = new int[cap];
+    for (int i = 0; i < cap; i++) {
+        position[i] = -1;
     }
 }
 
 Algorithms::PriorityQueue::~PriorityQueue() {
     delete[] heap;
+    delete[] position;
+}
+
+void Algorithms::PriorityQueue::siftUp(int i) {
+    Item item = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / arity;
+        if (heap[parent].priority <= item.priority) break;
+        heap[i] = heap[parent];
+        position[heap[i].vertex] = i;
+        i = parent;
+    }
+    heap[i] = item;
+    position[item.vertex] = i;
+}
+
+void Algorithms::PriorityQueue::siftDown(int i) {
+    Item item = heap[i];
+    while (true) {
+        int first = i * arity + 1;
+        if (first >= size) break;
+        int last = first + arity < size ? first + arity : size;
+        int smallest = first;
+        for (int c = first + 1; c < last; c++) {
+            if (heap[c].priority < heap[smallest].priority) {
+                smallest = c;
+            }
+        }
+        if (heap[smallest].priority >= item.priority) break;
+        heap[i] = heap[smallest];
+        position[heap[i].vertex] = i;
+        i = smallest;
+    }
+    heap[i] = item;
+    position[item.vertex] = i;
 }
 
 void Algorithms::PriorityQueue::insert(int vertex, int priority) {
-    if (size == capacity) {
-        throw std::runtime_error("Priority queue is full");
+    if (vertex < 0 || vertex >= capacity) {
+        throw std::out_of_range("Priority queue vertex out of range");
     }
-    heap[size] = Item(vertex, priority);
-    int i = size;
-    while (i > 0 && heap[(i-1)/2].priority > heap[i].priority) {
-        std::swap(heap[i], heap[(i-1)/2]);
-        i = (i-1)/2;
+    if (position[vertex] != -1) {
+        decreaseKey(vertex, priority);
+        return;
     }
+    heap[size] = Item(vertex, priority);
     size++;
+    siftUp(size - 1);
 }
 
 int Algorithms::PriorityQueue::extractMin() {
@@ -71,42 +138,147 @@ int Algorithms::PriorityQueue::extractMin() {
         throw std::runtime_error("Priority queue is empty");
     }
     int minVertex = heap[0].vertex;
-    heap[0] = heap[size-1];
+    position[minVertex] = -1;
     size--;
-    int i = 0;
-    while (true) {
-        int smallest = i;
-        int left = 2*i + 1;
-        int right = 2*i + 2;
-        if (left < size && heap[left].priority < heap[smallest].priority) {
-            smallest = left;
-        }
-        if (right < size && heap[right].priority < heap[smallest].priority) {
-            smallest = right;
-        }
-        if (smallest == i) break;
-        std::swap(heap[i], heap[smallest]);
-        i = smallest;
+    if (size > 0) {
+        heap[0] = heap[size];
+        siftDown(0);
     }
     return minVertex;
 }
 
 void Algorithms::PriorityQueue::decreaseKey(int vertex, int newPriority) {
-    int i = 0;
-    while (i < size && heap[i].vertex != vertex) i++;
-    if (i < size) {
-        heap[i].priority = newPriority;
-        while (i > 0 && heap[(i-1)/2].priority > heap[i].priority) {
-            std::swap(heap[i], heap[(i-1)/2]);
-            i = (i-1)/2;
-        }
+    int i = position[vertex];
+    if (i == -1 || heap[i].priority <= newPriority) return;
+    heap[i].priority = newPriority;
+    siftUp(i);
+}
+
+void Algorithms::PriorityQueue::clear() {
+    for (int i = 0; i < size; i++) {
+        position[heap[i].vertex] = -1;
     }
+    size = 0;
+}
+
+bool Algorithms::PriorityQueue::contains(int vertex) const {
+    return position[vertex] != -1;
 }
 
 bool Algorithms::PriorityQueue::isEmpty() const {
     return size == 0;
 }
 
+// BucketQueue implementation
+Algorithms::BucketQueue::BucketQueue(int cap, int maxKeyStep)
+    : buckets(maxKeyStep + 1), size(0), cursor(0) {
+    head = new int[buckets];
+    next = new int[cap];
+    prev = new int[cap];
+    slot = new int[cap];
+    for (int b = 0; b < buckets; b++) {
+        head[b] = -1;
+    }
+    for (int i = 0; i < cap; i++) {
+        slot[i] = -1;
+    }
+}
+
+Algorithms::BucketQueue::~BucketQueue() {
+    delete[] head;
+    delete[] next;
+    delete[] prev;
+    delete[] slot;
+}
+
+void Algorithms::BucketQueue::insert(int vertex, long long key) {
+    int b = (int)(key % buckets);
+    slot[vertex] = b;
+    prev[vertex] = -1;
+    next[vertex] = head[b];
+    if (head[b] != -1) prev[head[b]] = vertex;
+    head[b] = vertex;
+    size++;
+}
+
+void Algorithms::BucketQueue::unlink(int vertex) {
+    int b = slot[vertex];
+    if (prev[vertex] != -1) next[prev[vertex]] = next[vertex];
+    else head[b] = next[vertex];
+    if (next[vertex] != -1) prev[next[vertex]] = prev[vertex];
+    slot[vertex] = -1;
+    size--;
+}
+
+void Algorithms::BucketQueue::decreaseKey(int vertex, long long newKey) {
+    if (slot[vertex] != -1) unlink(vertex);
+    insert(vertex, newKey);
+}
+
+int Algorithms::BucketQueue::extractMin() {
+    if (isEmpty()) {
+        throw std::runtime_error("Bucket queue is empty");
+    }
+    // keys live in [cursor, cursor + buckets), so the ring never wraps onto itself
+    while (head[cursor % buckets] == -1) {
+        cursor++;
+    }
+    int vertex = head[cursor % buckets];
+    unlink(vertex);
+    return vertex;
+}
+
+// ContractionGraph implementation
+Algorithms::ContractionGraph::ContractionGraph(int n) : numVertices(n) {
+    lists = new ChArc*[n];
+    sizes = new int[n];
+    capacities = new int[n];
+    for (int i = 0; i < n; i++) {
+        lists[i] = new ChArc[4];
+        sizes[i] = 0;
+        capacities[i] = 4;
+    }
+}
+
+Algorithms::ContractionGraph::~ContractionGraph() {
+    for (int i = 0; i < numVertices; i++) {
+        delete[] lists[i];
+    }
+    delete[] lists;
+    delete[] sizes;
+    delete[] capacities;
+}
+
+void Algorithms::ContractionGraph::addOrLower(int u, int v, int weight, int middle) {
+    for (int i = 0; i < sizes[u]; i++) {
+        if (lists[u][i].vertex == v) {
+            if (weight < lists[u][i].weight) {
+                lists[u][i] = ChArc(v, weight, middle);
+            }
+            return;
+        }
+    }
+    if (sizes[u] == capacities[u]) {
+        ChArc* bigger = new ChArc[capacities[u] * 2];
+        for (int i = 0; i < sizes[u]; i++) {
+            bigger[i] = lists[u][i];
+        }
+        delete[] lists[u];
+        lists[u] = bigger;
+        capacities[u] *= 2;
+    }
+    lists[u][sizes[u]++] = ChArc(v, weight, middle);
+}
+
+void Algorithms::ContractionGraph::remove(int u, int v) {
+    for (int i = 0; i < sizes[u]; i++) {
+        if (lists[u][i].vertex == v) {
+            lists[u][i] = lists[u][--sizes[u]];
+            return;
+        }
+    }
+}
+
 // UnionFind implementation
 Algorithms::UnionFind::UnionFind(int n) : size(n) {
     parent = new int[n];
@@ -123,10 +295,19 @@ Algorithms::UnionFind::~UnionFind() {
 }
 
 int Algorithms::UnionFind::find(int x) {
-    if (parent[x] != x) {
-        parent[x] = find(parent[x]);
+    // path halving, no recursion on long chains
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+int Algorithms::UnionFind::findRoot(int x) const {
+    while (parent[x] != x) {
+        x = parent[x];
     }
-    return parent[x];
+    return x;
 }
 
 void Algorithms::UnionFind::unite(int x, int y) {
@@ -143,14 +324,150 @@ void Algorithms::UnionFind::unite(int x, int y) {
     }
 }
 
+// ConcurrentUnionFind implementation
+Algorithms::ConcurrentUnionFind::ConcurrentUnionFind(int n) : size(n) {
+    parent = new std::atomic<int>[n];
+    for (int i = 0; i < n; i++) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+Algorithms::ConcurrentUnionFind::~ConcurrentUnionFind() {
+    delete[] parent;
+}
+
+int Algorithms::ConcurrentUnionFind::find(int x) {
+    // parents only ever move to smaller indices, so pointing x at its
+    // grandparent is always safe, a failed CAS just means someone else did
+    while (true) {
+        int p = parent[x].load(std::memory_order_acquire);
+        if (p == x) return x;
+        int gp = parent[p].load(std::memory_order_acquire);
+        if (gp != p) {
+            parent[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+        }
+        x = p;
+    }
+}
+
+bool Algorithms::ConcurrentUnionFind::unite(int x, int y) {
+    while (true) {
+        x = find(x);
+        y = find(y);
+        if (x == y) return false;
+        if (x < y) {
+            int tmp = x;
+            x = y;
+            y = tmp;
+        }
+        // x can only be linked while it is still a root
+        int expected = x;
+        if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel)) {
+            return true;
+        }
+    }
+}
+
+bool Algorithms::ConcurrentUnionFind::sameSet(int x, int y) {
+    while (true) {
+        x = find(x);
+        y = find(y);
+        if (x == y) return true;
+        // different roots only count if x was not linked meanwhile
+        if (parent[x].load(std::memory_order_acquire) == x) return false;
+    }
+}
+
+// WeightTable implementation
+Algorithms::WeightTable::WeightTable(int cap) : usedCount(0), capacity(cap) {
+    keys = new int[cap];
+    values = new long long[cap];
+    used = new int[cap];
+    for (int i = 0; i < cap; i++) {
+        keys[i] = -1;
+    }
+}
+
+Algorithms::WeightTable::~WeightTable() {
+    delete[] keys;
+    delete[] values;
+    delete[] used;
+}
+
+void Algorithms::WeightTable::add(int key, long long weight) {
+    int slot = (int)(((unsigned)key * 2654435761u) & (unsigned)(capacity - 1));
+    while (keys[slot] != -1 && keys[slot] != key) {
+        slot = (slot + 1) & (capacity - 1);
+    }
+    if (keys[slot] == key) {
+        values[slot] += weight;
+        return;
+    }
+    keys[slot] = key;
+    values[slot] = weight;
+    used[usedCount++] = slot;
+    if (usedCount * 2 > capacity) grow();
+}
+
+long long Algorithms::WeightTable::get(int key) const {
+    int slot = (int)(((unsigned)key * 2654435761u) & (unsigned)(capacity - 1));
+    while (keys[slot] != -1) {
+        if (keys[slot] == key) return values[slot];
+        slot = (slot + 1) & (capacity - 1);
+    }
+    return 0;
+}
+
+void Algorithms::WeightTable::clear() {
+    for (int i = 0; i < usedCount; i++) {
+        keys[used[i]] = -1;
+    }
+    usedCount = 0;
+}
+
+void Algorithms::WeightTable::grow() {
+    int* oldKeys = keys;
+    long long* oldValues = values;
+    int* oldUsed = used;
+    int oldCount = usedCount;
+    capacity *= 2;
+    keys = new int[capacity];
+    values = new long long[capacity];
+    used = new int[capacity];
+    for (int i = 0; i < capacity; i++) {
+        keys[i] = -1;
+    }
+    usedCount = 0;
+    for (int i = 0; i < oldCount; i++) {
+        add(oldKeys[oldUsed[i]], oldValues[oldUsed[i]]);
+    }
+    delete[] oldKeys;
+    delete[] oldValues;
+    delete[] oldUsed;
+}
+
+// LevelGraph implementation
+Algorithms::LevelGraph::LevelGraph(int vertices, int* offs, int* list, long long* w)
+    : numVertices(vertices), offsets(offs), targets(list), weights(w) {}
+
+Algorithms::LevelGraph::~LevelGraph() {
+    delete[] offsets;
+    delete[] targets;
+    delete[] weights;
+}
+
 // Graph Algorithms Implementation
-Graph Algorithms::bfs(const Graph& g, int source) {
+template <typename G>
+TraversalResult Algorithms::bfsImpl(const G& g, int source) {
     int n = g.getNumVertices();
-    Graph result(n);
-    bool* visited = new bool[n]();
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+    TraversalResult result(n);
     Queue q(n);
     
-    visited[source] = true;
+    result.depth[source] = 0;
+    result.order[result.orderSize++] = source;
     q.enqueue(source);
     
     while (!q.isEmpty()) {
@@ -160,53 +477,121 @@ Graph Algorithms::bfs(const Graph& g, int source) {
         
         for (int i = 0; i < neighborCount; i++) {
             int v = neighbors[i].vertex;
-            if (!visited[v]) {
-                visited[v] = true;
-                result.addDirectedEdge(u, v, neighbors[i].weight);  // Use directed edge
+            if (result.depth[v] == -1) {
+                result.depth[v] = result.depth[u] + 1;
+                result.parent[v] = u;
+                result.parentWeight[v] = neighbors[i].weight;
+                result.order[result.orderSize++] = v;
                 q.enqueue(v);
             }
         }
     }
     
-    delete[] visited;
     return result;
 }
 
-Graph Algorithms::dfs(const Graph& g, int source) {
+// Iterative DFS from one root. Each stack frame is (vertex, index of the next
+// neighbor to look at), all frames live in one array of n entries, and the
+// clock ticks once on discovery and once on finish.
+template <typename G>
+void Algorithms::dfsVisit(const G& g, int root, DfsResult& result, DfsFrame* stack, int& clock, int& finished) {
+    int top = 0;
+    stack[0].vertex = root;
+    stack[0].next = 0;
+    result.depth[root] = 0;
+    result.discovery[root] = clock++;
+    result.order[result.orderSize++] = root;
+
+    while (top >= 0) {
+        DfsFrame& frame = stack[top];
+        int u = frame.vertex;
+        const Neighbor* neighbors = g.getNeighbors(u);
+        int neighborCount = g.getNeighborCount(u);
+
+        // advance to the next undiscovered neighbor
+        while (frame.next < neighborCount && result.discovery[neighbors[frame.next].vertex] != -1) {
+            frame.next++;
+        }
+
+        if (frame.next < neighborCount) {
+            const Neighbor& edge = neighbors[frame.next++];
+            int v = edge.vertex;
+            result.parent[v] = u;
+            result.parentWeight[v] = edge.weight;
+            result.depth[v] = top + 1;
+            result.discovery[v] = clock++;
+            result.order[result.orderSize++] = v;
+            top++;
+            stack[top].vertex = v;
+            stack[top].next = 0;
+        } else {
+            result.finish[u] = clock++;
+            result.postOrder[finished++] = u;
+            top--;
+        }
+    }
+}
+
+template <typename G>
+DfsResult Algorithms::dfsImpl(const G& g, int source) {
+    int n = g.getNumVertices();
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+    DfsResult result(n);
+    DfsFrame* stack = new DfsFrame[n];
+    int clock = 0;
+    int finished = 0;
+
+    dfsVisit(g, source, result, stack, clock, finished);
+
+    delete[] stack;
+    return result;
+}
+
+template <typename G>
+DfsResult Algorithms::dfsForestImpl(const G& g) {
     int n = g.getNumVertices();
-    Graph result(n);
-    bool* visited = new bool[n]();
-    
-    struct DFSHelper {
-        static void dfsVisit(const Graph& g, Graph& result, bool* visited, int u) {
-            visited[u] = true;
-            const Neighbor* neighbors = g.getNeighbors(u);
-            int neighborCount = g.getNeighborCount(u);
-            
-            for (int i = 0; i < neighborCount; i++) {
-                int v = neighbors[i].vertex;
-                if (!visited[v]) {
-                    result.addDirectedEdge(u, v, neighbors[i].weight);  // Use directed edge
-                    dfsVisit(g, result, visited, v);
-                }
-            }
+    DfsResult result(n);
+    DfsFrame* stack = new DfsFrame[n > 0 ? n : 1];
+    int clock = 0;
+    int finished = 0;
+
+    for (int root = 0; root < n; root++) {
+        if (result.discovery[root] == -1) {
+            dfsVisit(g, root, result, stack, clock, finished);
         }
-    };
-    
-    DFSHelper::dfsVisit(g, result, visited, source);
-    delete[] visited;
+    }
+
+    delete[] stack;
     return result;
 }
 
-Graph Algorithms::dijkstra(const Graph& g, int source) {
+template <typename G>
+ShortestPathResult Algorithms::dijkstraImpl(const G& g, int source) {
     int n = g.getNumVertices();
-    Graph result(n);
-    int* dist = new int[n];
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+
+    // small non-negative integer weights: buckets beat the heap
+    if (g.getMinWeight() >= 0 && g.getMaxWeight() <= DIAL_MAX_WEIGHT) {
+        return dialImpl(g, source, g.getMaxWeight());
+    }
+    return heapDijkstraImpl(g, source);
+}
+
+template <typename G>
+ShortestPathResult Algorithms::heapDijkstraImpl(const G& g, int source) {
+    int n = g.getNumVertices();
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+
+    ShortestPathResult result(n, source);
+    int* dist = result.dist;
     bool* visited = new bool[n]();
     
-    for (int i = 0; i < n; i++) {
-        dist[i] = INT_MAX;
-    }
     dist[source] = 0;
     
     PriorityQueue pq(n);
@@ -214,7 +599,6 @@ Graph Algorithms::dijkstra(const Graph& g, int source) {
     
     while (!pq.isEmpty()) {
         int u = pq.extractMin();
-        if (visited[u]) continue;
         visited[u] = true;
         
         const Neighbor* neighbors = g.getNeighbors(u);
@@ -224,22 +608,69 @@ Graph Algorithms::dijkstra(const Graph& g, int source) {
             int v = neighbors[i].vertex;
             int weight = neighbors[i].weight;
             
-            if (dist[u] != INT_MAX && dist[u] + weight < dist[v]) {
+            if (!visited[v] && dist[u] + weight < dist[v]) {
                 dist[v] = dist[u] + weight;
-                result.addDirectedEdge(u, v, weight);  // Use directed edge
-                pq.insert(v, dist[v]);
+                result.parent[v] = u;
+                pq.insert(v, dist[v]);  // decrease-key if already queued
             }
         }
     }
     
-    delete[] dist;
     delete[] visited;
     return result;
 }
 
-Graph Algorithms::prim(const Graph& g) {
+template <typename G>
+ShortestPathResult Algorithms::dialImpl(const G& g, int source, int maxWeight) {
+    int n = g.getNumVertices();
+    ShortestPathResult result(n, source);
+    int* dist = result.dist;
+    bool* visited = new bool[n]();
+
+    dist[source] = 0;
+
+    BucketQueue bq(n, maxWeight);
+    bq.insert(source, 0);
+
+    while (!bq.isEmpty()) {
+        int u = bq.extractMin();
+        visited[u] = true;
+
+        const Neighbor* neighbors = g.getNeighbors(u);
+        int neighborCount = g.getNeighborCount(u);
+
+        for (int i = 0; i < neighborCount; i++) {
+            int v = neighbors[i].vertex;
+            int weight = neighbors[i].weight;
+
+            if (!visited[v] && dist[u] + weight < dist[v]) {
+                dist[v] = dist[u] + weight;
+                result.parent[v] = u;
+                bq.decreaseKey(v, dist[v]);  // moves it if already queued
+            }
+        }
+    }
+
+    delete[] visited;
+    return result;
+}
+
+template <typename G>
+ShortestPathResult Algorithms::dialAuto(const G& g, int source) {
+    int n = g.getNumVertices();
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+    if (g.getMinWeight() < 0) {
+        throw std::invalid_argument("Dial's algorithm needs non-negative weights");
+    }
+    return dialImpl(g, source, g.getMaxWeight());
+}
+
+template <typename G>
+SpanningForest Algorithms::primImpl(const G& g) {
     int n = g.getNumVertices();
-    Graph result(n);
+    SpanningForest result(n);
     int* key = new int[n];
     int* parent = new int[n];
     bool* visited = new bool[n]();
@@ -248,31 +679,35 @@ Graph Algorithms::prim(const Graph& g) {
         key[i] = INT_MAX;
         parent[i] = -1;
     }
-    key[0] = 0;
     
     PriorityQueue pq(n);
-    pq.insert(0, 0);
     
-    while (!pq.isEmpty()) {
-        int u = pq.extractMin();
-        if (visited[u]) continue;
-        visited[u] = true;
-        
-        if (parent[u] != -1) {
-            result.addEdge(parent[u], u, key[u]);
-        }
-        
-        const Neighbor* neighbors = g.getNeighbors(u);
-        int neighborCount = g.getNeighborCount(u);
+    // restart from every vertex the previous trees did not reach
+    for (int root = 0; root < n; root++) {
+        if (visited[root]) continue;
+        key[root] = 0;
+        pq.insert(root, 0);
         
-        for (int i = 0; i < neighborCount; i++) {
-            int v = neighbors[i].vertex;
-            int weight = neighbors[i].weight;
+        while (!pq.isEmpty()) {
+            int u = pq.extractMin();
+            visited[u] = true;
             
-            if (!visited[v] && weight < key[v]) {
-                parent[v] = u;
-                key[v] = weight;
-                pq.insert(v, key[v]);
+            if (parent[u] != -1) {
+                result.add(parent[u], u, key[u]);
+            }
+            
+            const Neighbor* neighbors = g.getNeighbors(u);
+            int neighborCount = g.getNeighborCount(u);
+            
+            for (int i = 0; i < neighborCount; i++) {
+                int v = neighbors[i].vertex;
+                int weight = neighbors[i].weight;
+                
+                if (!visited[v] && weight < key[v]) {
+                    parent[v] = u;
+                    key[v] = weight;
+                    pq.insert(v, key[v]);  // decrease-key if already queued
+                }
             }
         }
     }
@@ -283,64 +718,2957 @@ Graph Algorithms::prim(const Graph& g) {
     return result;
 }
 
-Graph Algorithms::kruskal(const Graph& g) {
+// Bidirectional Dijkstra. A forward search from the source and a backward
+// search from the target take turns, each time the side whose queue minimum
+// is smaller settles one vertex. Every edge that touches a vertex the other
+// side has labeled is a candidate meeting point, and once the two queue
+// minima add up to at least the best candidate no shorter path can exist.
+PathResult Algorithms::shortestPath(const CsrGraph& g, const CsrGraph& reverse, int source, int target) {
     int n = g.getNumVertices();
-    Graph result(n);
-    UnionFind uf(n);
-    
-    // Create edge list
-    struct Edge {
-        int u, v, weight;
-        Edge(int u, int v, int w) : u(u), v(v), weight(w) {}
-        bool operator<(const Edge& other) const {
-            return weight < other.weight;
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::invalid_argument("Vertex index out of bounds");
+    }
+    if (reverse.getNumVertices() != n) {
+        throw std::invalid_argument("Reverse graph has a different vertex count");
+    }
+    if (g.getMinWeight() < 0 || reverse.getMinWeight() < 0) {
+        throw std::invalid_argument("Bidirectional search needs non-negative weights");
+    }
+    PathResult result;
+    if (source == target) {
+        result.distance = 0;
+        result.path = new int[1];
+        result.path[0] = source;
+        result.length = 1;
+        return result;
+    }
+
+    int* dist[2];
+    int* parent[2];
+    bool* settled[2];
+    for (int side = 0; side < 2; side++) {
+        dist[side] = new int[n];
+        parent[side] = new int[n];
+        settled[side] = new bool[n]();
+        for (int v = 0; v < n; v++) {
+            dist[side][v] = INT_MAX;
+            parent[side][v] = -1;
         }
-    };
-    
-    // Collect all edges
-    Edge** edges = new Edge*[n * n];
-    int edgeCount = 0;
-    
-    for (int u = 0; u < n; u++) {
-        const Neighbor* neighbors = g.getNeighbors(u);
-        int neighborCount = g.getNeighborCount(u);
-        
+    }
+    const CsrGraph* graphs[2] = {&g, &reverse};
+    PriorityQueue forward(n), backward(n);
+    PriorityQueue* queues[2] = {&forward, &backward};
+
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    forward.insert(source, 0);
+    backward.insert(target, 0);
+
+    long long best = INT_MAX;
+    int meeting = -1;
+
+    while (!forward.isEmpty() && !backward.isEmpty()) {
+        if ((long long)forward.minPriority() + backward.minPriority() >= best) break;
+
+        int side = forward.minPriority() <= backward.minPriority() ? 0 : 1;
+        int other = 1 - side;
+        int u = queues[side]->extractMin();
+        settled[side][u] = true;
+        result.settled++;
+
+        const Neighbor* neighbors = graphs[side]->getNeighbors(u);
+        int neighborCount = graphs[side]->getNeighborCount(u);
         for (int i = 0; i < neighborCount; i++) {
             int v = neighbors[i].vertex;
-            if (u < v) {  // Avoid duplicate edges
-                edges[edgeCount] = new Edge(u, v, neighbors[i].weight);
-                edgeCount++;
+            int weight = neighbors[i].weight;
+            int candidate = dist[side][u] + weight;
+            if (!settled[side][v] && candidate < dist[side][v]) {
+                dist[side][v] = candidate;
+                parent[side][v] = u;
+                queues[side]->insert(v, candidate);  // decrease-key if already queued
             }
-        }
-    }
-    
-    // Sort edges
-    for (int i = 0; i < edgeCount - 1; i++) {
-        for (int j = 0; j < edgeCount - i - 1; j++) {
-            if (edges[j]->weight > edges[j + 1]->weight) {
-                std::swap(edges[j], edges[j + 1]);
+            if (dist[other][v] != INT_MAX && (long long)dist[side][v] + dist[other][v] < best) {
+                best = (long long)dist[side][v] + dist[other][v];
+                meeting = v;
             }
         }
     }
-    
-    // Process edges
-    for (int i = 0; i < edgeCount; i++) {
-        int u = edges[i]->u;
-        int v = edges[i]->v;
-        
-        if (uf.find(u) != uf.find(v)) {
-            result.addEdge(u, v, edges[i]->weight);
-            uf.unite(u, v);
-        }
+
+    if (meeting != -1) {
+        result.distance = (int)best;
+        int before = 0, after = 0;
+        for (int v = meeting; v != source; v = parent[0][v]) before++;
+        for (int v = meeting; v != target; v = parent[1][v]) after++;
+        result.length = before + after + 1;
+        result.path = new int[result.length];
+        int i = before;
+        for (int v = meeting; i >= 0; v = parent[0][v]) result.path[i--] = v;
+        i = before + 1;
+        for (int v = parent[1][meeting]; i < result.length; v = parent[1][v]) result.path[i++] = v;
     }
-    
-    // Clean up
-    for (int i = 0; i < edgeCount; i++) {
-        delete edges[i];
+
+    for (int side = 0; side < 2; side++) {
+        delete[] dist[side];
+        delete[] parent[side];
+        delete[] settled[side];
     }
-    delete[] edges;
-    
     return result;
 }
 
-} // namespace graph 
\ No newline at end of file
+PathResult Algorithms::shortestPath(const CsrGraph& g, int source, int target) {
+    return shortestPath(g, g, source, target);
+}
+
+PathResult Algorithms::shortestPath(const Graph& g, int source, int target) {
+    CsrGraph csr = g.freeze();
+    return shortestPath(csr, csr, source, target);
+}
+
+// A* keeps the usual Dijkstra labels but orders the queue by dist + h. A vertex
+// whose label drops after it was taken out is simply queued again, so an
+// admissible but inconsistent heuristic still gives exact answers.
+PathResult Algorithms::aStarSearch(const CsrGraph& g, int source, int target,
+                                   int (*heuristic)(void* context, int vertex), void* context) {
+    int n = g.getNumVertices();
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::invalid_argument("Vertex index out of bounds");
+    }
+    if (g.getMinWeight() < 0) {
+        throw std::invalid_argument("A* needs non-negative weights");
+    }
+    PathResult result;
+    int* dist = new int[n];
+    int* parent = new int[n];
+    for (int v = 0; v < n; v++) {
+        dist[v] = INT_MAX;
+        parent[v] = -1;
+    }
+
+    PriorityQueue pq(n);
+    dist[source] = 0;
+    pq.insert(source, heuristic(context, source));
+
+    while (!pq.isEmpty()) {
+        int u = pq.extractMin();
+        result.settled++;
+        if (u == target) break;
+
+        const Neighbor* neighbors = g.getNeighbors(u);
+        int neighborCount = g.getNeighborCount(u);
+        for (int i = 0; i < neighborCount; i++) {
+            int v = neighbors[i].vertex;
+            int weight = neighbors[i].weight;
+            if (dist[u] + weight < dist[v]) {
+                dist[v] = dist[u] + weight;
+                parent[v] = u;
+                pq.insert(v, dist[v] + heuristic(context, v));
+            }
+        }
+    }
+
+    if (dist[target] != INT_MAX) {
+        result.distance = dist[target];
+        for (int v = target; v != -1; v = parent[v]) result.length++;
+        result.path = new int[result.length];
+        int i = result.length - 1;
+        for (int v = target; v != -1; v = parent[v]) result.path[i--] = v;
+    }
+
+    delete[] dist;
+    delete[] parent;
+    return result;
+}
+
+// Landmark selection. Farthest: start from the vertex farthest from vertex 0,
+// then keep adding the vertex whose nearest landmark is farthest away.
+// Avoid: grow a shortest path tree from a root, weigh every vertex by how far
+// the current bounds are from its real distance, and walk down the heaviest
+// subtrees that hold no landmark yet to a leaf, which becomes the landmark.
+LandmarkIndex Algorithms::buildLandmarks(const CsrGraph& g, int count, LandmarkSelection selection) {
+    int n = g.getNumVertices();
+    if (count < 0 || count > n) {
+        throw std::invalid_argument("Landmark count out of range");
+    }
+    LandmarkIndex index(n, count);
+    index.numLandmarks = 0;
+    bool* isLandmark = new bool[n > 0 ? n : 1]();
+    int* childOffsets = new int[n + 1];
+    int* children = new int[n > 0 ? n : 1];
+    int* stack = new int[n > 0 ? n : 1];
+    int* preorder = new int[n > 0 ? n : 1];
+    long long* size = new long long[n > 0 ? n : 1];
+    bool* hasLandmark = new bool[n > 0 ? n : 1];
+    unsigned seed = 12345u;
+
+    auto addLandmark = [&](int landmark) {
+        ShortestPathResult sp = dijkstra(g, landmark);
+        int* row = index.dist + (long long)index.numLandmarks * n;
+        for (int v = 0; v < n; v++) row[v] = sp.dist[v];
+        index.landmarks[index.numLandmarks++] = landmark;
+        isLandmark[landmark] = true;
+    };
+
+    while (index.numLandmarks < count) {
+        int pick = -1;
+
+        if (selection == LandmarkSelection::Farthest) {
+            if (index.numLandmarks == 0) {
+                ShortestPathResult sp = dijkstra(g, 0);
+                pick = 0;
+                for (int v = 0; v < n; v++) {
+                    if (sp.reached(v) && sp.dist[v] > sp.dist[pick]) pick = v;
+                }
+            } else {
+                // an unreachable vertex counts as infinitely far (new component)
+                long long bestGap = -1;
+                for (int v = 0; v < n; v++) {
+                    if (isLandmark[v]) continue;
+                    long long nearest = LLONG_MAX;
+                    for (int l = 0; l < index.numLandmarks; l++) {
+                        int d = index.dist[(long long)l * n + v];
+                        long long gap = d == INT_MAX ? LLONG_MAX : d;
+                        if (gap < nearest) nearest = gap;
+                    }
+                    if (nearest > bestGap) {
+                        bestGap = nearest;
+                        pick = v;
+                    }
+                }
+            }
+        } else {
+            seed = seed * 1103515245u + 12345u;
+            int root = (int)((seed >> 8) % (unsigned)n);
+            ShortestPathResult sp = dijkstra(g, root);
+
+            // children of every vertex in the shortest path tree
+            for (int v = 0; v <= n; v++) childOffsets[v] = 0;
+            for (int v = 0; v < n; v++) {
+                if (sp.parent[v] != -1) childOffsets[sp.parent[v] + 1]++;
+            }
+            for (int v = 0; v < n; v++) childOffsets[v + 1] += childOffsets[v];
+            for (int v = 0; v < n; v++) stack[v] = childOffsets[v];
+            for (int v = 0; v < n; v++) {
+                if (sp.parent[v] != -1) children[stack[sp.parent[v]]++] = v;
+            }
+
+            // pre-order from the root, then sizes bottom up in reverse. A
+            // subtree that already holds a landmark is worth nothing.
+            int visited = 0;
+            int top = 0;
+            stack[top++] = root;
+            while (top > 0) {
+                int u = stack[--top];
+                preorder[visited++] = u;
+                for (int i = childOffsets[u]; i < childOffsets[u + 1]; i++) stack[top++] = children[i];
+            }
+            for (int i = visited - 1; i >= 0; i--) {
+                int u = preorder[i];
+                size[u] = sp.dist[u] - index.lowerBound(u, root);
+                hasLandmark[u] = isLandmark[u];
+                for (int c = childOffsets[u]; c < childOffsets[u + 1]; c++) {
+                    size[u] += size[children[c]];
+                    if (hasLandmark[children[c]]) hasLandmark[u] = true;
+                }
+                if (hasLandmark[u]) size[u] = 0;
+            }
+
+            // walk down the heaviest subtrees to a leaf
+            int u = root;
+            while (true) {
+                int heaviest = -1;
+                for (int c = childOffsets[u]; c < childOffsets[u + 1]; c++) {
+                    int child = children[c];
+                    if (size[child] > 0 && (heaviest == -1 || size[child] > size[heaviest])) heaviest = child;
+                }
+                if (heaviest == -1) break;
+                u = heaviest;
+            }
+            pick = u;
+            if (isLandmark[pick]) {
+                // nothing left to cover from this root, take any unused vertex
+                pick = -1;
+                for (int v = 0; v < n && pick == -1; v++) {
+                    if (!isLandmark[v]) pick = v;
+                }
+            }
+        }
+
+        addLandmark(pick);
+    }
+
+    delete[] isLandmark;
+    delete[] childOffsets;
+    delete[] children;
+    delete[] stack;
+    delete[] preorder;
+    delete[] size;
+    delete[] hasLandmark;
+    return index;
+}
+
+PathResult Algorithms::altShortestPath(const CsrGraph& g, const LandmarkIndex& index, int source, int target) {
+    if (index.numVertices != g.getNumVertices()) {
+        throw std::invalid_argument("Landmark index belongs to a different graph");
+    }
+    return aStar(g, source, target, [&index, target](int v) { return index.lowerBound(v, target); });
+}
+
+// Contraction Hierarchies (Geisberger et al.). Vertices are contracted one at
+// a time, cheapest first by edge difference (shortcuts added minus edges
+// removed) plus the number of already contracted neighbors. Priorities are
+// updated lazily: a popped vertex is re-evaluated and goes back in the queue
+// if it is no longer the cheapest. Contracting v connects every pair of its
+// remaining neighbors u, w with a shortcut over v, unless a local witness
+// search finds a path u..w at most as short that avoids v. The arcs v still
+// has when it gets contracted are exactly its upward arcs.
+ContractionHierarchy Algorithms::buildContractionHierarchy(const CsrGraph& g) {
+    const int WITNESS_SETTLE_LIMIT = 50;
+    int n = g.getNumVertices();
+
+    ContractionGraph cg(n);
+    for (int u = 0; u < n; u++) {
+        const Neighbor* neighbors = g.getNeighbors(u);
+        int neighborCount = g.getNeighborCount(u);
+        for (int i = 0; i < neighborCount; i++) {
+            if (neighbors[i].weight < 0) {
+                throw std::invalid_argument("Contraction hierarchies need non-negative weights");
+            }
+            cg.addOrLower(u, neighbors[i].vertex, neighbors[i].weight, -1);
+            cg.addOrLower(neighbors[i].vertex, u, neighbors[i].weight, -1);
+        }
+    }
+
+    int* contractedNeighbors = new int[n > 0 ? n : 1]();
+    int* rank = new int[n > 0 ? n : 1];
+    int* witnessDist = new int[n > 0 ? n : 1];
+    for (int v = 0; v < n; v++) witnessDist[v] = INT_MAX;
+    bool* isTarget = new bool[n > 0 ? n : 1]();
+    Buffer touched;
+    Buffer shortcuts;       // triples u, w, weight
+    PriorityQueue witnessQueue(n > 0 ? n : 1);
+
+    // shortcuts contracting v would need, left in the shortcuts buffer
+    auto findShortcuts = [&](int v) {
+        shortcuts.clear();
+        ChArc* list = cg.lists[v];
+        int degree = cg.sizes[v];
+        int maxWeight = 0;
+        for (int i = 0; i < degree; i++) {
+            if (list[i].weight > maxWeight) maxWeight = list[i].weight;
+        }
+        for (int i = 0; i + 1 < degree; i++) {
+            int u = list[i].vertex;
+
+            // only pairs (u, w) with w later in the list are checked from u
+            int farthest = 0;
+            int targets = 0;
+            for (int j = i + 1; j < degree; j++) {
+                if (list[j].weight > farthest) farthest = list[j].weight;
+                isTarget[list[j].vertex] = true;
+                targets++;
+            }
+            long long bound = (long long)list[i].weight + farthest;
+
+            // Dijkstra from u that never enters v, stops once every target is
+            // settled, the bound is passed or the settle limit is hit
+            witnessDist[u] = 0;
+            touched.push(u);
+            witnessQueue.insert(u, 0);
+            int settled = 0;
+            while (!witnessQueue.isEmpty() && settled < WITNESS_SETTLE_LIMIT && targets > 0) {
+                int x = witnessQueue.extractMin();
+                if (witnessDist[x] > bound) break;
+                settled++;
+                if (isTarget[x]) targets--;
+                for (int k = 0; k < cg.sizes[x]; k++) {
+                    int y = cg.lists[x][k].vertex;
+                    if (y == v) continue;
+                    int d = witnessDist[x] + cg.lists[x][k].weight;
+                    if (d < witnessDist[y]) {
+                        if (witnessDist[y] == INT_MAX) touched.push(y);
+                        witnessDist[y] = d;
+                        witnessQueue.insert(y, d);
+                    }
+                }
+            }
+            witnessQueue.clear();
+
+            for (int j = i + 1; j < degree; j++) {
+                int w = list[j].vertex;
+                int viaV = list[i].weight + list[j].weight;
+                if (witnessDist[w] > viaV) {
+                    shortcuts.push(u);
+                    shortcuts.push(w);
+                    shortcuts.push(viaV);
+                }
+            }
+            for (int j = i + 1; j < degree; j++) isTarget[list[j].vertex] = false;
+            for (int k = 0; k < touched.size; k++) witnessDist[touched.data[k]] = INT_MAX;
+            touched.clear();
+        }
+    };
+
+    auto priority = [&](int v) {
+        findShortcuts(v);
+        return shortcuts.size / 3 - cg.sizes[v] + contractedNeighbors[v];
+    };
+
+    PriorityQueue order(n > 0 ? n : 1);
+    for (int v = 0; v < n; v++) order.insert(v, priority(v));
+
+    // upward arcs collected per vertex, turned into CSR at the end
+    int* offsets = new int[n + 1];
+    ChArc** up = new ChArc*[n > 0 ? n : 1];
+    int next = 0;
+
+    while (!order.isEmpty()) {
+        int v = order.extractMin();
+        int current = priority(v);   // also leaves v's shortcuts in the buffer
+        if (!order.isEmpty() && current > order.minPriority()) {
+            order.insert(v, current);
+            continue;
+        }
+
+        rank[v] = next++;
+        offsets[v] = cg.sizes[v];
+        up[v] = new ChArc[cg.sizes[v] > 0 ? cg.sizes[v] : 1];
+        for (int i = 0; i < cg.sizes[v]; i++) up[v][i] = cg.lists[v][i];
+
+        for (int k = 0; k < shortcuts.size; k += 3) {
+            cg.addOrLower(shortcuts.data[k], shortcuts.data[k + 1], shortcuts.data[k + 2], v);
+            cg.addOrLower(shortcuts.data[k + 1], shortcuts.data[k], shortcuts.data[k + 2], v);
+        }
+        for (int i = 0; i < offsets[v]; i++) {
+            int u = up[v][i].vertex;
+            cg.remove(u, v);
+            contractedNeighbors[u]++;
+        }
+        // neighbors usually got cheaper or dearer, refresh the cheaper ones now
+        for (int i = 0; i < offsets[v]; i++) {
+            int u = up[v][i].vertex;
+            order.insert(u, priority(u));
+        }
+    }
+
+    // sizes -> offsets, then copy the per vertex arcs into one array
+    int total = 0;
+    for (int v = 0; v < n; v++) {
+        int count = offsets[v];
+        offsets[v] = total;
+        total += count;
+    }
+    offsets[n] = total;
+    ChArc* arcs = new ChArc[total > 0 ? total : 1];
+    for (int v = 0; v < n; v++) {
+        for (int i = offsets[v]; i < offsets[v + 1]; i++) arcs[i] = up[v][i - offsets[v]];
+        delete[] up[v];
+    }
+
+    delete[] up;
+    delete[] contractedNeighbors;
+    delete[] witnessDist;
+    delete[] isTarget;
+    return ContractionHierarchy(n, rank, offsets, arcs);
+}
+
+ContractionHierarchy Algorithms::buildContractionHierarchy(const Graph& g) {
+    return buildContractionHierarchy(g.freeze());
+}
+
+PathResult Algorithms::chShortestPath(const ContractionHierarchy& ch, int source, int target) {
+    ChQuery query(ch);
+    return query.shortestPath(source, target);
+}
+
+// Direction-optimizing BFS (Beamer, Asanovic, Patterson). result.order doubles
+// as the queue: the current level is order[levelBegin .. levelEnd). Top-down
+// steps push from that window, bottom-up steps let every unvisited vertex
+// look for a parent in a bitmap of the current level and stop at the first
+// hit, which skips most edges on the big middle levels of low diameter graphs.
+TraversalResult Algorithms::bfsDirectionOptimizing(const CsrGraph& g, const CsrGraph& incoming,
+                                                   int source, int alpha, int beta) {
+    int n = g.getNumVertices();
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+    if (incoming.getNumVertices() != n) {
+        throw std::invalid_argument("Incoming graph has a different vertex count");
+    }
+    if (alpha < 1 || beta < 1) {
+        throw std::invalid_argument("alpha and beta must be positive");
+    }
+    TraversalResult result(n);
+    int* order = result.order;
+    int* depth = result.depth;
+
+    int words = (n + 63) / 64;
+    uint64_t* front = new uint64_t[words];
+    uint64_t* next = new uint64_t[words];
+
+    depth[source] = 0;
+    order[result.orderSize++] = source;
+    int levelBegin = 0;
+    int level = 0;
+    long long scout = g.getNeighborCount(source);        // edges out of the frontier
+    long long edgesToCheck = g.getNumArcs() - scout;      // edges out of unvisited vertices
+
+    while (levelBegin < result.orderSize) {
+        int levelEnd = result.orderSize;
+
+        if (scout > edgesToCheck / alpha) {
+            // switch to bottom-up, the frontier becomes a bitmap
+            for (int w = 0; w < words; w++) front[w] = 0;
+            for (int i = levelBegin; i < levelEnd; i++) {
+                front[order[i] >> 6] |= (uint64_t)1 << (order[i] & 63);
+            }
+            int awake = levelEnd - levelBegin;
+            int oldAwake;
+            do {
+                oldAwake = awake;
+                awake = 0;
+                for (int w = 0; w < words; w++) next[w] = 0;
+                for (int v = 0; v < n; v++) {
+                    if (depth[v] != -1) continue;
+                    const Neighbor* neighbors = incoming.getNeighbors(v);
+                    int neighborCount = incoming.getNeighborCount(v);
+                    for (int i = 0; i < neighborCount; i++) {
+                        int u = neighbors[i].vertex;
+                        if (front[u >> 6] & ((uint64_t)1 << (u & 63))) {
+                            depth[v] = level + 1;
+                            result.parent[v] = u;
+                            result.parentWeight[v] = neighbors[i].weight;
+                            next[v >> 6] |= (uint64_t)1 << (v & 63);
+                            order[result.orderSize++] = v;
+                            edgesToCheck -= g.getNeighborCount(v);
+                            awake++;
+                            break;
+                        }
+                    }
+                }
+                uint64_t* tmp = front;
+                front = next;
+                next = tmp;
+                level++;
+            } while (awake > 0 && (awake >= oldAwake || awake > n / beta));
+
+            // back to top-down on the last level found, or finish
+            levelBegin = result.orderSize - awake;
+            scout = 0;
+            for (int i = levelBegin; i < result.orderSize; i++) {
+                scout += g.getNeighborCount(order[i]);
+            }
+            continue;
+        }
+
+        // top-down step
+        scout = 0;
+        for (int i = levelBegin; i < levelEnd; i++) {
+            int u = order[i];
+            const Neighbor* neighbors = g.getNeighbors(u);
+            int neighborCount = g.getNeighborCount(u);
+            for (int j = 0; j < neighborCount; j++) {
+                int v = neighbors[j].vertex;
+                if (depth[v] == -1) {
+                    depth[v] = level + 1;
+                    result.parent[v] = u;
+                    result.parentWeight[v] = neighbors[j].weight;
+                    order[result.orderSize++] = v;
+                    scout += g.getNeighborCount(v);
+                }
+            }
+        }
+        edgesToCheck -= scout;
+        levelBegin = levelEnd;
+        level++;
+    }
+
+    delete[] front;
+    delete[] next;
+    return result;
+}
+
+TraversalResult Algorithms::bfsDirectionOptimizing(const CsrGraph& g, int source, int alpha, int beta) {
+    return bfsDirectionOptimizing(g, g, source, alpha, beta);
+}
+
+TraversalResult Algorithms::bfsDirectionOptimizing(const Graph& g, int source, int alpha, int beta) {
+    // a Graph may hold directed arcs, so bottom-up steps read real incoming lists
+    CsrGraph csr = g.freeze();
+    CsrGraph incoming = csr.transpose();
+    return bfsDirectionOptimizing(csr, incoming, source, alpha, beta);
+}
+
+// Parallel BFS. One team of threads runs the whole search and meets at a
+// barrier after every level. Frontier chunks are handed out through a work
+// stealing range, a vertex is claimed by the thread whose compare-and-swap
+// moves its depth from -1, and every thread collects what it claimed in a
+// local buffer. The buffers are then copied back to back into result.order,
+// which is the next frontier.
+TraversalResult Algorithms::parallelBfs(const CsrGraph& g, int source, int numThreads) {
+    int n = g.getNumVertices();
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+    const int CHUNK = 64;
+    int threads = parallel::threadCount(numThreads);
+    TraversalResult result(n);
+    int* order = result.order;
+
+    std::atomic<int>* depth = new std::atomic<int>[n];
+    for (int v = 0; v < n; v++) depth[v].store(-1, std::memory_order_relaxed);
+    depth[source].store(0, std::memory_order_relaxed);
+    order[0] = source;
+
+    Buffer* local = new Buffer[threads];
+    int* offsets = new int[threads + 1];
+    int levelBegin = 0;
+    int levelEnd = 1;
+    int level = 0;
+
+    parallel::Barrier barrier(threads);
+    parallel::WorkStealingRange range(threads, CHUNK);
+    range.reset(levelBegin, levelEnd);
+
+    parallel::run(threads, [&](int t) {
+        Buffer& mine = local[t];
+        while (levelBegin < levelEnd) {
+            mine.clear();
+            int lo, hi;
+            while (range.next(t, lo, hi)) {
+                for (int i = lo; i < hi; i++) {
+                    int u = order[i];
+                    const Neighbor* neighbors = g.getNeighbors(u);
+                    int neighborCount = g.getNeighborCount(u);
+                    for (int j = 0; j < neighborCount; j++) {
+                        int v = neighbors[j].vertex;
+                        int unseen = -1;
+                        if (depth[v].load(std::memory_order_relaxed) == -1 &&
+                            depth[v].compare_exchange_strong(unseen, level + 1,
+                                                             std::memory_order_relaxed)) {
+                            result.parent[v] = u;
+                            result.parentWeight[v] = neighbors[j].weight;
+                            mine.push(v);
+                        }
+                    }
+                }
+            }
+            barrier.wait();
+
+            if (t == 0) {
+                offsets[0] = levelEnd;
+                for (int k = 0; k < threads; k++) offsets[k + 1] = offsets[k] + local[k].size;
+            }
+            barrier.wait();
+
+            for (int i = 0; i < mine.size; i++) order[offsets[t] + i] = mine.data[i];
+            barrier.wait();
+
+            if (t == 0) {
+                levelBegin = levelEnd;
+                levelEnd = offsets[threads];
+                level++;
+                range.reset(levelBegin, levelEnd);
+            }
+            barrier.wait();
+        }
+    });
+
+    result.orderSize = levelEnd;
+    for (int v = 0; v < n; v++) result.depth[v] = depth[v].load(std::memory_order_relaxed);
+
+    delete[] depth;
+    delete[] local;
+    delete[] offsets;
+    return result;
+}
+
+TraversalResult Algorithms::parallelBfs(const Graph& g, int source, int numThreads) {
+    return parallelBfs(g.freeze(), source, numThreads);
+}
+
+// Multi-source BFS (Then et al.). Bit i of a vertex's masks belongs to the i-th
+// source of the batch: seen says which searches reached it, visit which have
+// it on their current frontier. One pass over the adjacency ORs every
+// frontier vertex's visit mask into its neighbors, so up to 64 searches
+// advance a level for the price of one. Lanes are plain 64-bit words; there
+// is no 256-lane SIMD variant.
+MultiSourceDistances Algorithms::multiSourceBfs(const CsrGraph& g, const int* sources, int count,
+                                                int numThreads) {
+    const int LANES = 64;
+    int n = g.getNumVertices();
+    if (count < 0) {
+        throw std::invalid_argument("Source count must not be negative");
+    }
+    for (int i = 0; i < count; i++) {
+        if (sources[i] < 0 || sources[i] >= n) {
+            throw std::invalid_argument("Source vertex out of bounds");
+        }
+    }
+    MultiSourceDistances result(count, n);
+    int batches = (count + LANES - 1) / LANES;
+    int threads = parallel::threadCount(numThreads);
+    if (threads > batches) threads = batches > 0 ? batches : 1;
+
+    // one batch per chunk, each thread keeps its own masks. Masks start out
+    // zero and only the vertices a batch reached are cleared after it, and
+    // each level walks the frontier list, so a batch costs its own reach
+    // instead of n per level.
+    parallel::WorkStealingRange range(threads, 1);
+    range.reset(0, batches);
+    parallel::run(threads, [&](int t) {
+        int size = n > 0 ? n : 1;
+        uint64_t* seen = new uint64_t[size]();
+        uint64_t* visit = new uint64_t[size]();
+        uint64_t* visitNext = new uint64_t[size]();
+        int* frontier = new int[size];
+        int* touched = new int[size];       // vertices with visitNext != 0
+        int* reached = new int[size];       // vertices with seen != 0
+        int lo, hi;
+        while (range.next(t, lo, hi)) {
+            int first = lo * LANES;
+            int lanes = count - first < LANES ? count - first : LANES;
+            int frontierSize = 0, reachedSize = 0;
+            for (int i = 0; i < lanes; i++) {
+                int s = sources[first + i];
+                if (seen[s] == 0) {
+                    frontier[frontierSize++] = s;
+                    reached[reachedSize++] = s;
+                }
+                seen[s] |= (uint64_t)1 << i;
+                visit[s] |= (uint64_t)1 << i;
+                result.dist[(long long)(first + i) * n + s] = 0;
+            }
+
+            for (int level = 1; frontierSize > 0; level++) {
+                int touchedSize = 0;
+                for (int f = 0; f < frontierSize; f++) {
+                    int v = frontier[f];
+                    uint64_t bits = visit[v];
+                    visit[v] = 0;
+                    const Neighbor* neighbors = g.getNeighbors(v);
+                    int neighborCount = g.getNeighborCount(v);
+                    for (int j = 0; j < neighborCount; j++) {
+                        int w = neighbors[j].vertex;
+                        if (visitNext[w] == 0) touched[touchedSize++] = w;
+                        visitNext[w] |= bits;
+                    }
+                }
+                frontierSize = 0;
+                for (int k = 0; k < touchedSize; k++) {
+                    int v = touched[k];
+                    uint64_t fresh = visitNext[v] & ~seen[v];
+                    visitNext[v] = 0;
+                    if (fresh == 0) continue;
+                    if (seen[v] == 0) reached[reachedSize++] = v;
+                    seen[v] |= fresh;
+                    visit[v] = fresh;
+                    frontier[frontierSize++] = v;
+                    while (fresh) {
+                        int i = __builtin_ctzll(fresh);
+                        result.dist[(long long)(first + i) * n + v] = level;
+                        fresh &= fresh - 1;
+                    }
+                }
+            }
+            for (int k = 0; k < reachedSize; k++) seen[reached[k]] = 0;
+        }
+        delete[] seen;
+        delete[] visit;
+        delete[] visitNext;
+        delete[] frontier;
+        delete[] touched;
+        delete[] reached;
+    });
+
+    return result;
+}
+
+MultiSourceDistances Algorithms::multiSourceBfs(const Graph& g, const int* sources, int count, int numThreads) {
+    return multiSourceBfs(g.freeze(), sources, count, numThreads);
+}
+
+// Delta-stepping (Meyer and Sanders). Tentative distances are sorted into
+// buckets of width delta. The lowest non-empty bucket is emptied by relaxing
+// only light edges (weight <= delta) until nothing falls back into it, then
+// the heavy edges of every vertex settled there are relaxed once, since they
+// can only reach later buckets. Distance and parent are packed into one
+// 64-bit word so a single compare-and-swap lowers both. Every thread has its
+// own ring of maxWeight / delta + 2 buckets, enough for any relaxation target.
+ShortestPathResult Algorithms::deltaStepping(const CsrGraph& g, int source, int delta, int numThreads) {
+    int n = g.getNumVertices();
+    if (source < 0 || source >= n) {
+        throw std::invalid_argument("Source vertex out of bounds");
+    }
+    if (g.getMinWeight() < 0) {
+        throw std::invalid_argument("Delta-stepping needs non-negative weights");
+    }
+    int maxWeight = g.getMaxWeight();
+    if (delta <= 0) {
+        // default: the average edge weight
+        long long weightSum = 0;
+        const Neighbor* all = g.getNeighbors(0);
+        for (int i = 0; i < g.getNumArcs(); i++) weightSum += all[i].weight;
+        delta = g.getNumArcs() > 0 ? (int)(weightSum / g.getNumArcs()) : 1;
+        if (delta < 1) delta = 1;
+    }
+
+    const int CHUNK = 64;
+    int threads = parallel::threadCount(numThreads);
+    int ring = maxWeight / delta + 2;
+
+    auto pack = [](int d, int p) { return ((uint64_t)(uint32_t)d << 32) | (uint32_t)p; };
+    auto distOf = [](uint64_t x) { return (int)(x >> 32); };
+
+    std::atomic<uint64_t>* state = new std::atomic<uint64_t>[n];
+    std::atomic<int>* settledIn = new std::atomic<int>[n];   // last bucket that put v in R
+    for (int v = 0; v < n; v++) {
+        state[v].store(pack(INT_MAX, -1), std::memory_order_relaxed);
+        settledIn[v].store(-1, std::memory_order_relaxed);
+    }
+    state[source].store(pack(0, -1), std::memory_order_relaxed);
+
+    Buffer* bins = new Buffer[threads * ring];       // bins[t * ring + bucket % ring]
+    Buffer* settled = new Buffer[threads];           // R, vertices removed from the bucket
+    bins[0].push(source);
+
+    int* frontier = new int[16];
+    int frontierCapacity = 16;
+    int frontierSize = 0;
+    int* offsets = new int[threads + 1];
+    long long current = 0;
+    bool done = false;
+
+    parallel::Barrier barrier(threads);
+    parallel::WorkStealingRange range(threads, CHUNK);
+
+    // lowers v to newDist through u, files v under its new bucket
+    auto relax = [&](int t, int u, int v, int newDist) {
+        uint64_t seen = state[v].load(std::memory_order_relaxed);
+        while (newDist < distOf(seen)) {
+            if (state[v].compare_exchange_weak(seen, pack(newDist, u), std::memory_order_relaxed)) {
+                bins[t * ring + (int)((newDist / delta) % ring)].push(v);
+                return;
+            }
+        }
+    };
+
+    parallel::run(threads, [&](int t) {
+        while (true) {
+            barrier.wait();
+            if (t == 0) {
+                // next non-empty bucket, at most one ring ahead
+                done = true;
+                for (int k = 0; k < ring && done; k++) {
+                    int slot = (int)((current + k) % ring);
+                    for (int w = 0; w < threads; w++) {
+                        if (bins[w * ring + slot].size > 0) {
+                            current += k;
+                            done = false;
+                            break;
+                        }
+                    }
+                }
+            }
+            barrier.wait();
+            if (done) break;
+            int slot = (int)(current % ring);
+
+            // light phase, repeats while the bucket refills itself
+            while (true) {
+                if (t == 0) {
+                    offsets[0] = 0;
+                    for (int w = 0; w < threads; w++) offsets[w + 1] = offsets[w] + bins[w * ring + slot].size;
+                    frontierSize = offsets[threads];
+                    if (frontierSize > frontierCapacity) {
+                        delete[] frontier;
+                        frontierCapacity = frontierSize * 2;
+                        frontier = new int[frontierCapacity];
+                    }
+                    range.reset(0, frontierSize);
+                }
+                barrier.wait();
+                Buffer& mine = bins[t * ring + slot];
+                for (int i = 0; i < mine.size; i++) frontier[offsets[t] + i] = mine.data[i];
+                mine.clear();
+                barrier.wait();
+                if (frontierSize == 0) break;
+
+                int lo, hi;
+                while (range.next(t, lo, hi)) {
+                    for (int i = lo; i < hi; i++) {
+                        int u = frontier[i];
+                        int d = distOf(state[u].load(std::memory_order_relaxed));
+                        if (d / delta != current) continue;  // stale entry
+                        if (settledIn[u].exchange((int)current, std::memory_order_relaxed) != (int)current) {
+                            settled[t].push(u);
+                        }
+                        const Neighbor* neighbors = g.getNeighbors(u);
+                        int neighborCount = g.getNeighborCount(u);
+                        for (int j = 0; j < neighborCount; j++) {
+                            if (neighbors[j].weight <= delta) {
+                                relax(t, u, neighbors[j].vertex, d + neighbors[j].weight);
+                            }
+                        }
+                    }
+                }
+                barrier.wait();
+            }
+
+            // heavy phase, settled distances are final now
+            Buffer& mySettled = settled[t];
+            for (int i = 0; i < mySettled.size; i++) {
+                int u = mySettled.data[i];
+                int d = distOf(state[u].load(std::memory_order_relaxed));
+                const Neighbor* neighbors = g.getNeighbors(u);
+                int neighborCount = g.getNeighborCount(u);
+                for (int j = 0; j < neighborCount; j++) {
+                    if (neighbors[j].weight > delta) {
+                        relax(t, u, neighbors[j].vertex, d + neighbors[j].weight);
+                    }
+                }
+            }
+            mySettled.clear();
+            if (t == 0) current++;
+        }
+    });
+
+    ShortestPathResult result(n, source);
+    for (int v = 0; v < n; v++) {
+        uint64_t x = state[v].load(std::memory_order_relaxed);
+        result.dist[v] = distOf(x);
+        result.parent[v] = (int)(uint32_t)x;
+    }
+
+    delete[] state;
+    delete[] settledIn;
+    delete[] bins;
+    delete[] settled;
+    delete[] frontier;
+    delete[] offsets;
+    return result;
+}
+
+ShortestPathResult Algorithms::deltaStepping(const Graph& g, int source, int delta, int numThreads) {
+    return deltaStepping(g.freeze(), source, delta, numThreads);
+}
+
+// Edge list helpers
+template <typename G>
+int Algorithms::collectEdges(const G& g, Edge*& edges) {
+    int n = g.getNumVertices();
+
+    // count first so the array is exactly as big as the edge set
+    int edgeCount = 0;
+    for (int u = 0; u < n; u++) {
+        const Neighbor* neighbors = g.getNeighbors(u);
+        int neighborCount = g.getNeighborCount(u);
+        for (int i = 0; i < neighborCount; i++) {
+            if (u < neighbors[i].vertex) edgeCount++;  // Avoid duplicate edges
+        }
+    }
+
+    edges = new Edge[edgeCount > 0 ? edgeCount : 1];
+    int k = 0;
+    for (int u = 0; u < n; u++) {
+        const Neighbor* neighbors = g.getNeighbors(u);
+        int neighborCount = g.getNeighborCount(u);
+        for (int i = 0; i < neighborCount; i++) {
+            int v = neighbors[i].vertex;
+            if (u < v) {
+                edges[k].u = u;
+                edges[k].v = v;
+                edges[k].weight = neighbors[i].weight;
+                k++;
+            }
+        }
+    }
+    return edgeCount;
+}
+
+// LSD radix sort on the weight, one byte per pass. Stable, O(E) per pass,
+// and passes where every key has the same byte are skipped. Big arrays are
+// split into one chunk per thread: each thread histograms its chunk, the
+// histograms are turned into per-thread output offsets, then every thread
+// scatters its own chunk.
+void Algorithms::sortEdges(Edge* edges, int count, int numThreads) {
+    const int RADIX = 256;
+    const int PARALLEL_CUTOFF = 1 << 16;
+    if (count < 2) return;
+
+    int threads = count < PARALLEL_CUTOFF ? 1 : parallel::threadCount(numThreads);
+    Edge* buffer = new Edge[count];
+    int* counts = new int[threads * RADIX];
+    int* bounds = new int[threads + 1];
+    for (int t = 0; t <= threads; t++) {
+        bounds[t] = (int)((long long)count * t / threads);
+    }
+
+    Edge* from = edges;
+    Edge* to = buffer;
+    for (int shift = 0; shift < 32; shift += 8) {
+        // flip the sign bit so negative weights come first
+        auto digit = [shift](const Edge& e) {
+            return (int)(((unsigned)e.weight ^ 0x80000000u) >> shift) & (RADIX - 1);
+        };
+
+        parallel::run(threads, [&](int t) {
+            int* hist = counts + t * RADIX;
+            for (int b = 0; b < RADIX; b++) hist[b] = 0;
+            for (int i = bounds[t]; i < bounds[t + 1]; i++) hist[digit(from[i])]++;
+        });
+
+        // skip the pass if all keys landed in one bucket
+        int firstDigit = digit(from[0]);
+        int sameDigit = 0;
+        for (int t = 0; t < threads; t++) sameDigit += counts[t * RADIX + firstDigit];
+        if (sameDigit == count) continue;
+
+        // bucket major, thread minor keeps the sort stable
+        int running = 0;
+        for (int b = 0; b < RADIX; b++) {
+            for (int t = 0; t < threads; t++) {
+                int c = counts[t * RADIX + b];
+                counts[t * RADIX + b] = running;
+                running += c;
+            }
+        }
+
+        parallel::run(threads, [&](int t) {
+            int* next = counts + t * RADIX;
+            for (int i = bounds[t]; i < bounds[t + 1]; i++) {
+                to[next[digit(from[i])]++] = from[i];
+            }
+        });
+
+        Edge* tmp = from;
+        from = to;
+        to = tmp;
+    }
+
+    if (from != edges) {
+        for (int i = 0; i < count; i++) edges[i] = from[i];
+    }
+    delete[] buffer;
+    delete[] counts;
+    delete[] bounds;
+}
+
+template <typename G>
+SpanningForest Algorithms::kruskalImpl(const G& g) {
+    int n = g.getNumVertices();
+    SpanningForest result(n);
+    UnionFind uf(n);
+
+    Edge* edges = nullptr;
+    int edgeCount = collectEdges(g, edges);
+    sortEdges(edges, edgeCount, 0);
+
+    // Process edges, a spanning forest never has more than n - 1 of them
+    for (int i = 0; i < edgeCount && result.edgeCount < n - 1; i++) {
+        int u = edges[i].u;
+        int v = edges[i].v;
+
+        if (uf.find(u) != uf.find(v)) {
+            result.add(u, v, edges[i].weight);
+            uf.unite(u, v);
+        }
+    }
+
+    delete[] edges;
+    return result;
+}
+
+template <typename Keep>
+int Algorithms::partitionEdges(Edge* edges, Edge* scratch, int count, int threads, Keep keep) {
+    int* kept = new int[threads + 1];
+    int* dropped = new int[threads + 1];
+
+    // count per slice, then every slice writes to its own place in scratch
+    parallel::run(threads, [&](int t) {
+        int lo = (int)((long long)count * t / threads);
+        int hi = (int)((long long)count * (t + 1) / threads);
+        int k = 0;
+        for (int i = lo; i < hi; i++) {
+            if (keep(edges[i])) k++;
+        }
+        kept[t + 1] = k;
+        dropped[t + 1] = (hi - lo) - k;
+    });
+    kept[0] = 0;
+    dropped[0] = 0;
+    for (int t = 0; t < threads; t++) {
+        kept[t + 1] += kept[t];
+        dropped[t + 1] += dropped[t];
+    }
+    int total = kept[threads];
+    parallel::run(threads, [&](int t) {
+        int lo = (int)((long long)count * t / threads);
+        int hi = (int)((long long)count * (t + 1) / threads);
+        int in = kept[t];
+        int out = total + dropped[t];
+        for (int i = lo; i < hi; i++) {
+            if (keep(edges[i])) scratch[in++] = edges[i];
+            else scratch[out++] = edges[i];
+        }
+    });
+    parallel::run(threads, [&](int t) {
+        int lo = (int)((long long)count * t / threads);
+        int hi = (int)((long long)count * (t + 1) / threads);
+        for (int i = lo; i < hi; i++) edges[i] = scratch[i];
+    });
+
+    delete[] kept;
+    delete[] dropped;
+    return total;
+}
+
+// One level of Filter-Kruskal (Osipov, Sanders, Singler) on edges[0..count).
+void Algorithms::filterKruskalStep(Edge* edges, Edge* scratch, int count, int threads,
+                                   UnionFind& uf, SpanningForest& result) {
+    const int BASE_CASE = 1 << 12;
+    const int PARALLEL_CUTOFF = 1 << 16;
+    if (count == 0 || result.edgeCount == result.numVertices - 1) return;
+    int splitThreads = count < PARALLEL_CUTOFF ? 1 : threads;
+
+    // median of three as pivot, edges <= pivot are light
+    int pivot = 0;
+    int split = count;
+    if (count > BASE_CASE) {
+        int a = edges[0].weight;
+        int b = edges[count / 2].weight;
+        int c = edges[count - 1].weight;
+        pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+        split = partitionEdges(edges, scratch, count, splitThreads,
+                               [pivot](const Edge& e) { return e.weight <= pivot; });
+        if (split == count) {
+            // pivot was the maximum, split below it instead
+            split = partitionEdges(edges, scratch, count, splitThreads,
+                                   [pivot](const Edge& e) { return e.weight < pivot; });
+        }
+    }
+
+    if (split == 0 || split == count) {
+        // small, or every weight is the same: plain Kruskal
+        sortEdges(edges, count, splitThreads);
+        for (int i = 0; i < count && result.edgeCount < result.numVertices - 1; i++) {
+            if (uf.find(edges[i].u) != uf.find(edges[i].v)) {
+                uf.unite(edges[i].u, edges[i].v);
+                result.add(edges[i].u, edges[i].v, edges[i].weight);
+            }
+        }
+        return;
+    }
+
+    filterKruskalStep(edges, scratch, split, threads, uf, result);
+
+    // heavy edges inside one tree can never be picked, drop them unsorted
+    Edge* heavy = edges + split;
+    int heavyCount = count - split;
+    const UnionFind& forest = uf;
+    int useful = partitionEdges(heavy, scratch + split, heavyCount,
+                                heavyCount < PARALLEL_CUTOFF ? 1 : threads,
+                                [&forest](const Edge& e) { return forest.findRoot(e.u) != forest.findRoot(e.v); });
+    filterKruskalStep(heavy, scratch + split, useful, threads, uf, result);
+}
+
+SpanningForest Algorithms::filterKruskal(const CsrGraph& g, int numThreads) {
+    int n = g.getNumVertices();
+    SpanningForest result(n);
+    UnionFind uf(n > 0 ? n : 1);
+    int threads = parallel::threadCount(numThreads);
+
+    Edge* edges = nullptr;
+    int edgeCount = collectEdges(g, edges);
+    Edge* scratch = new Edge[edgeCount > 0 ? edgeCount : 1];
+
+    filterKruskalStep(edges, scratch, edgeCount, threads, uf, result);
+
+    delete[] edges;
+    delete[] scratch;
+    return result;
+}
+
+SpanningForest Algorithms::filterKruskal(const Graph& g, int numThreads) {
+    return filterKruskal(g.freeze(), numThreads);
+}
+
+// Parallel Boruvka. Every round each component picks its lightest outgoing
+// edge, found in parallel with an atomic minimum over (weight, edge id)
+// keys, where the id breaks ties so the picks can never close a cycle. The
+// picked edges join the forest and merge their components in parallel
+// through a shared concurrent union-find. Then every remaining edge is
+// relabeled to component ids and the ones now inside a single component are
+// dropped, so each round works on a smaller graph.
+SpanningForest Algorithms::boruvka(const CsrGraph& g, int numThreads) {
+    const int CHUNK = 1024;
+    int n = g.getNumVertices();
+    SpanningForest result(n);
+    int threads = parallel::threadCount(numThreads);
+
+    Edge* original = nullptr;
+    int edgeCount = collectEdges(g, original);
+
+    // working copy: endpoints become component ids, id points into original
+    struct RoundEdge {
+        int u, v, id;
+    };
+    RoundEdge* edges = new RoundEdge[edgeCount > 0 ? edgeCount : 1];
+    RoundEdge* spare = new RoundEdge[edgeCount > 0 ? edgeCount : 1];
+    for (int i = 0; i < edgeCount; i++) {
+        edges[i].u = original[i].u;
+        edges[i].v = original[i].v;
+        edges[i].id = i;
+    }
+
+    std::atomic<uint64_t>* best = new std::atomic<uint64_t>[n > 0 ? n : 1];
+    int* component = new int[n > 0 ? n : 1];
+    int* taken = new int[n > 0 ? n : 1];
+    int* kept = new int[threads + 1];
+    ConcurrentUnionFind uf(n > 0 ? n : 1);
+    const uint64_t NONE = ~(uint64_t)0;
+    auto keyOf = [&](int id) {
+        return ((uint64_t)((uint32_t)original[id].weight ^ 0x80000000u) << 32) | (uint32_t)id;
+    };
+
+    while (edgeCount > 0) {
+        // lightest edge out of every component
+        parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+            best[v].store(NONE, std::memory_order_relaxed);
+        });
+        parallel::forEach(0, edgeCount, threads, CHUNK, [&](int, int i) {
+            uint64_t key = keyOf(edges[i].id);
+            for (int end : {edges[i].u, edges[i].v}) {
+                uint64_t current = best[end].load(std::memory_order_relaxed);
+                while (key < current &&
+                       !best[end].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+                }
+            }
+        });
+
+        // merge along the picked edges, an edge picked from both sides
+        // is only taken by the thread whose unite actually merged
+        parallel::forEach(0, n, threads, CHUNK, [&](int, int c) {
+            uint64_t key = best[c].load(std::memory_order_relaxed);
+            taken[c] = -1;
+            if (key == NONE) return;
+            int id = (int)(uint32_t)key;
+            if (uf.unite(original[id].u, original[id].v)) taken[c] = id;
+        });
+        for (int c = 0; c < n; c++) {
+            if (taken[c] >= 0) {
+                const Edge& e = original[taken[c]];
+                result.add(e.u, e.v, e.weight);
+            }
+        }
+        parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+            component[v] = uf.find(v);
+        });
+
+        // relabel and drop edges that are now internal, every thread
+        // compacts its own slice so the survivors keep their order
+        parallel::run(threads, [&](int t) {
+            int lo = (int)((long long)edgeCount * t / threads);
+            int hi = (int)((long long)edgeCount * (t + 1) / threads);
+            int count = 0;
+            for (int i = lo; i < hi; i++) {
+                if (component[edges[i].u] != component[edges[i].v]) count++;
+            }
+            kept[t + 1] = count;
+        });
+        kept[0] = 0;
+        for (int t = 0; t < threads; t++) kept[t + 1] += kept[t];
+        parallel::run(threads, [&](int t) {
+            int lo = (int)((long long)edgeCount * t / threads);
+            int hi = (int)((long long)edgeCount * (t + 1) / threads);
+            int out = kept[t];
+            for (int i = lo; i < hi; i++) {
+                int cu = component[edges[i].u];
+                int cv = component[edges[i].v];
+                if (cu != cv) {
+                    spare[out].u = cu;
+                    spare[out].v = cv;
+                    spare[out].id = edges[i].id;
+                    out++;
+                }
+            }
+        });
+        RoundEdge* tmp = edges;
+        edges = spare;
+        spare = tmp;
+        edgeCount = kept[threads];
+    }
+
+    delete[] original;
+    delete[] edges;
+    delete[] spare;
+    delete[] best;
+    delete[] component;
+    delete[] taken;
+    delete[] kept;
+    return result;
+}
+
+SpanningForest Algorithms::boruvka(const Graph& g, int numThreads) {
+    return boruvka(g.freeze(), numThreads);
+}
+
+// Afforest (Sutton, Ben-Nun, Barak). Linking every vertex to its first few
+// neighbors already joins most of a typical graph into one big component.
+// A small random sample finds that component, and the final pass skips the
+// remaining edges of all its vertices: for undirected graphs any edge leaving
+// it is also seen from its other end. Links go through the concurrent
+// union-find, whose roots are the smallest vertex of every set.
+ComponentLabels Algorithms::connectedComponents(const CsrGraph& g, int numThreads) {
+    const int CHUNK = 1024;
+    const int NEIGHBOR_ROUNDS = 2;
+    const int SAMPLES = 1024;
+    int n = g.getNumVertices();
+    ComponentLabels result(n);
+    if (n == 0) return result;
+    int threads = parallel::threadCount(numThreads);
+    ConcurrentUnionFind uf(n);
+
+    // link along the first neighbors, compressing after each round
+    for (int r = 0; r < NEIGHBOR_ROUNDS; r++) {
+        parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+            if (g.getNeighborCount(v) > r) {
+                uf.unite(v, g.getNeighbors(v)[r].vertex);
+            }
+        });
+        parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+            uf.find(v);
+        });
+    }
+
+    // most common root among a few random vertices
+    int* table = new int[2 * SAMPLES];
+    int* hits = new int[2 * SAMPLES];
+    for (int i = 0; i < 2 * SAMPLES; i++) {
+        table[i] = -1;
+        hits[i] = 0;
+    }
+    unsigned seed = 12345u;
+    int largest = -1;
+    int largestHits = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int root = uf.find((int)((seed >> 8) % (unsigned)n));
+        int slot = (int)(((unsigned)root * 2654435761u) % (unsigned)(2 * SAMPLES));
+        while (table[slot] != -1 && table[slot] != root) {
+            slot = (slot + 1) % (2 * SAMPLES);
+        }
+        table[slot] = root;
+        if (++hits[slot] > largestHits) {
+            largestHits = hits[slot];
+            largest = root;
+        }
+    }
+    delete[] table;
+    delete[] hits;
+
+    // everything else, skipping vertices already in the big component
+    parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+        if (uf.find(v) == largest) return;
+        const Neighbor* list = g.getNeighbors(v);
+        int degree = g.getNeighborCount(v);
+        for (int i = NEIGHBOR_ROUNDS; i < degree; i++) {
+            uf.unite(v, list[i].vertex);
+        }
+    });
+
+    // roots in id order become the component numbers
+    int* offset = new int[threads + 1];
+    parallel::run(threads, [&](int t) {
+        int lo = (int)((long long)n * t / threads);
+        int hi = (int)((long long)n * (t + 1) / threads);
+        int count = 0;
+        for (int v = lo; v < hi; v++) {
+            if (uf.find(v) == v) count++;
+        }
+        offset[t + 1] = count;
+    });
+    offset[0] = 0;
+    for (int t = 0; t < threads; t++) offset[t + 1] += offset[t];
+    parallel::run(threads, [&](int t) {
+        int lo = (int)((long long)n * t / threads);
+        int hi = (int)((long long)n * (t + 1) / threads);
+        int id = offset[t];
+        for (int v = lo; v < hi; v++) {
+            if (uf.find(v) == v) result.component[v] = id++;
+        }
+    });
+    parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+        int root = uf.find(v);
+        if (root != v) result.component[v] = result.component[root];
+    });
+    result.numComponents = offset[threads];
+    delete[] offset;
+    return result;
+}
+
+ComponentLabels Algorithms::connectedComponents(const Graph& g, int numThreads) {
+    return connectedComponents(g.freeze(), numThreads);
+}
+
+// Same level structure as parallelBfs, the caller decides what to queue.
+template <typename Expand>
+int Algorithms::sweepFrontier(int* queue, int size, int threads, Expand expand) {
+    const int CHUNK = 64;
+    Buffer* local = new Buffer[threads];
+    int* offsets = new int[threads + 1];
+    int levelBegin = 0;
+    int levelEnd = size;
+
+    parallel::Barrier barrier(threads);
+    parallel::WorkStealingRange range(threads, CHUNK);
+    range.reset(levelBegin, levelEnd);
+
+    parallel::run(threads, [&](int t) {
+        Buffer& mine = local[t];
+        while (levelBegin < levelEnd) {
+            mine.clear();
+            int lo, hi;
+            while (range.next(t, lo, hi)) {
+                for (int i = lo; i < hi; i++) expand(queue[i], mine);
+            }
+            barrier.wait();
+
+            if (t == 0) {
+                offsets[0] = levelEnd;
+                for (int k = 0; k < threads; k++) offsets[k + 1] = offsets[k] + local[k].size;
+            }
+            barrier.wait();
+
+            for (int i = 0; i < mine.size; i++) queue[offsets[t] + i] = mine.data[i];
+            barrier.wait();
+
+            if (t == 0) {
+                levelBegin = levelEnd;
+                levelEnd = offsets[threads];
+                range.reset(levelBegin, levelEnd);
+            }
+            barrier.wait();
+        }
+    });
+
+    delete[] local;
+    delete[] offsets;
+    return levelEnd;
+}
+
+// Iterative Tarjan. A visited vertex that inside() still accepts is on the
+// component stack, so no separate on-stack flags are needed. Every finished
+// component is labeled with its root.
+template <typename Inside, typename Assign>
+void Algorithms::tarjanRun(const CsrGraph& g, const int* roots, int rootCount, Inside inside, Assign assign,
+                           int* index, int* low, DfsFrame* frames, Buffer& stack) {
+    int counter = 0;
+    for (int r = 0; r < rootCount; r++) {
+        int root = roots != nullptr ? roots[r] : r;
+        if (!inside(root) || index[root] != -1) continue;
+        int top = 0;
+        frames[top++] = {root, 0};
+        index[root] = low[root] = counter++;
+        stack.push(root);
+
+        while (top > 0) {
+            DfsFrame& frame = frames[top - 1];
+            int v = frame.vertex;
+            if (frame.next < g.getNeighborCount(v)) {
+                int w = g.getNeighbors(v)[frame.next++].vertex;
+                if (!inside(w)) continue;
+                if (index[w] == -1) {
+                    index[w] = low[w] = counter++;
+                    stack.push(w);
+                    frames[top++] = {w, 0};
+                } else if (index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+
+            top--;
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = stack.data[--stack.size];
+                    assign(w, v);
+                } while (w != v);
+            }
+            if (top > 0) {
+                int parent = frames[top - 1].vertex;
+                if (low[v] < low[parent]) low[parent] = low[v];
+            }
+        }
+    }
+}
+
+void Algorithms::tarjanScc(const CsrGraph& g, int* label) {
+    int n = g.getNumVertices();
+    int* index = new int[n > 0 ? n : 1];
+    int* low = new int[n > 0 ? n : 1];
+    DfsFrame* frames = new DfsFrame[n > 0 ? n : 1];
+    Buffer stack;
+    for (int v = 0; v < n; v++) index[v] = -1;
+
+    tarjanRun(g, nullptr, n, [&](int w) { return label[w] == -1; },
+              [&](int w, int root) { label[w] = root; }, index, low, frames, stack);
+
+    delete[] index;
+    delete[] low;
+    delete[] frames;
+}
+
+// A vertex with no unlabeled predecessor or no unlabeled successor sits on
+// no cycle, so it is a component by itself. Removing it can expose more, so
+// the remaining degrees are counted down and every vertex that hits zero
+// joins the next level.
+void Algorithms::trimScc(const CsrGraph& g, const CsrGraph& incoming, std::atomic<int>* label, int threads) {
+    const int CHUNK = 1024;
+    int n = g.getNumVertices();
+    std::atomic<int>* outDegree = new std::atomic<int>[n > 0 ? n : 1];
+    std::atomic<int>* inDegree = new std::atomic<int>[n > 0 ? n : 1];
+    int* queue = new int[n > 0 ? n : 1];
+
+    auto unlabeledDegree = [&](const CsrGraph& dir, int v) {
+        const Neighbor* list = dir.getNeighbors(v);
+        int count = 0;
+        for (int i = 0; i < dir.getNeighborCount(v); i++) {
+            int w = list[i].vertex;
+            if (w != v && label[w].load(std::memory_order_relaxed) == -1) count++;
+        }
+        return count;
+    };
+    parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+        if (label[v].load(std::memory_order_relaxed) != -1) return;
+        outDegree[v].store(unlabeledDegree(g, v), std::memory_order_relaxed);
+        inDegree[v].store(unlabeledDegree(incoming, v), std::memory_order_relaxed);
+    });
+
+    int size = 0;
+    for (int v = 0; v < n; v++) {
+        if (label[v].load(std::memory_order_relaxed) == -1 &&
+            (outDegree[v].load(std::memory_order_relaxed) == 0 ||
+             inDegree[v].load(std::memory_order_relaxed) == 0)) {
+            label[v].store(v, std::memory_order_relaxed);
+            queue[size++] = v;
+        }
+    }
+
+    // whoever labels a vertex first queues it
+    auto claim = [&](int w, Buffer& out) {
+        int unlabeled = -1;
+        if (label[w].compare_exchange_strong(unlabeled, w, std::memory_order_relaxed)) out.push(w);
+    };
+    sweepFrontier(queue, size, threads, [&](int u, Buffer& out) {
+        const Neighbor* list = g.getNeighbors(u);
+        for (int i = 0; i < g.getNeighborCount(u); i++) {
+            int w = list[i].vertex;
+            if (w == u || label[w].load(std::memory_order_relaxed) != -1) continue;
+            if (inDegree[w].fetch_sub(1, std::memory_order_relaxed) == 1) claim(w, out);
+        }
+        list = incoming.getNeighbors(u);
+        for (int i = 0; i < incoming.getNeighborCount(u); i++) {
+            int w = list[i].vertex;
+            if (w == u || label[w].load(std::memory_order_relaxed) != -1) continue;
+            if (outDegree[w].fetch_sub(1, std::memory_order_relaxed) == 1) claim(w, out);
+        }
+    });
+
+    delete[] outDegree;
+    delete[] inDegree;
+    delete[] queue;
+}
+
+void Algorithms::reachUnlabeled(const CsrGraph& g, int source, const std::atomic<int>* label,
+                                std::atomic<char>* mark, char bit, int* queue, int threads) {
+    mark[source].fetch_or(bit, std::memory_order_relaxed);
+    queue[0] = source;
+    sweepFrontier(queue, 1, threads, [&](int u, Buffer& out) {
+        const Neighbor* list = g.getNeighbors(u);
+        for (int i = 0; i < g.getNeighborCount(u); i++) {
+            int w = list[i].vertex;
+            if (label[w].load(std::memory_order_relaxed) != -1) continue;
+            if ((mark[w].load(std::memory_order_relaxed) & bit) == 0 &&
+                (mark[w].fetch_or(bit, std::memory_order_relaxed) & bit) == 0) {
+                out.push(w);
+            }
+        }
+    });
+}
+
+void Algorithms::finishScc(const CsrGraph& g, SccResult& result) {
+    int n = g.getNumVertices();
+    int* label = result.component;
+
+    // representative vertices -> 0..k-1 in order of first appearance
+    int* id = new int[n > 0 ? n : 1];
+    for (int v = 0; v < n; v++) id[v] = -1;
+    int count = 0;
+    for (int v = 0; v < n; v++) {
+        if (id[label[v]] == -1) id[label[v]] = count++;
+        label[v] = id[label[v]];
+    }
+    result.numComponents = count;
+
+    // members of every component back to back
+    int* start = new int[count + 1];
+    int* members = new int[n > 0 ? n : 1];
+    for (int c = 0; c <= count; c++) start[c] = 0;
+    for (int v = 0; v < n; v++) start[label[v] + 1]++;
+    for (int c = 0; c < count; c++) start[c + 1] += start[c];
+    int* fill = id;     // reused as insert positions
+    for (int c = 0; c < count; c++) fill[c] = start[c];
+    for (int v = 0; v < n; v++) members[fill[label[v]]++] = v;
+
+    // one arc per neighboring component, seen[] remembers where it went
+    int* offs = new int[count + 1];
+    Neighbor* list = new Neighbor[g.getNumArcs() > 0 ? g.getNumArcs() : 1];
+    int* seen = new int[count > 0 ? count : 1];
+    int* slot = fill;
+    for (int c = 0; c < count; c++) seen[c] = -1;
+    int arcs = 0;
+    for (int c = 0; c < count; c++) {
+        offs[c] = arcs;
+        for (int m = start[c]; m < start[c + 1]; m++) {
+            int v = members[m];
+            const Neighbor* neighbors = g.getNeighbors(v);
+            for (int i = 0; i < g.getNeighborCount(v); i++) {
+                int d = label[neighbors[i].vertex];
+                if (d == c) continue;
+                if (seen[d] != c) {
+                    seen[d] = c;
+                    slot[d] = arcs;
+                    list[arcs++] = Neighbor(d, neighbors[i].weight);
+                } else if (neighbors[i].weight < list[slot[d]].weight) {
+                    list[slot[d]].weight = neighbors[i].weight;
+                }
+            }
+        }
+    }
+    offs[count] = arcs;
+    result.condensation = CsrGraph(count, offs, list);
+
+    delete[] id;
+    delete[] start;
+    delete[] members;
+    delete[] seen;
+}
+
+Algorithms::SccScratch::SccScratch(int vertices) {
+    int size = vertices > 0 ? vertices : 1;
+    index = new int[size];
+    low = new int[size];
+    degree = new int[size];
+    queue = new int[size];
+    frames = new DfsFrame[size];
+    mark = new char[size]();
+    for (int v = 0; v < size; v++) index[v] = -1;
+}
+
+Algorithms::SccScratch::~SccScratch() {
+    delete[] index;
+    delete[] low;
+    delete[] degree;
+    delete[] queue;
+    delete[] frames;
+    delete[] mark;
+}
+
+// Everything a task touches has its color, and colors are never reused, so
+// tasks on different subproblems share the arrays without stepping on each
+// other. A component is the pivot's forward set met with its backward set;
+// every other component lies wholly in one of the three remainders.
+void Algorithms::sccTask(const CsrGraph& g, const CsrGraph& incoming, int* order, int lo, int hi,
+                         std::atomic<int>* color, std::atomic<int>& nextColor, std::atomic<int>* label,
+                         SccScratch& scratch, parallel::RangePool& pool) {
+    const int SEQUENTIAL_SIZE = 256;
+    int c = color[order[lo]].load(std::memory_order_relaxed);
+    auto inside = [&](int w) { return color[w].load(std::memory_order_relaxed) == c; };
+    auto assign = [&](int w, int root) {
+        label[w].store(root, std::memory_order_relaxed);
+        color[w].store(-1, std::memory_order_relaxed);
+    };
+
+    if (hi - lo <= SEQUENTIAL_SIZE) {
+        tarjanRun(g, order + lo, hi - lo, inside, assign, scratch.index, scratch.low, scratch.frames,
+                  scratch.stack);
+        for (int k = lo; k < hi; k++) scratch.index[order[k]] = -1;
+        return;
+    }
+
+    // trim, with degrees counted inside the subproblem
+    int* in = scratch.low;
+    int* out = scratch.degree;
+    int* queue = scratch.queue;
+    for (int k = lo; k < hi; k++) {
+        int v = order[k];
+        in[v] = 0;
+        out[v] = 0;
+        for (int i = 0; i < g.getNeighborCount(v); i++) {
+            int w = g.getNeighbors(v)[i].vertex;
+            if (w != v && inside(w)) out[v]++;
+        }
+        for (int i = 0; i < incoming.getNeighborCount(v); i++) {
+            int w = incoming.getNeighbors(v)[i].vertex;
+            if (w != v && inside(w)) in[v]++;
+        }
+    }
+    int size = 0;
+    for (int k = lo; k < hi; k++) {
+        int v = order[k];
+        if (in[v] == 0 || out[v] == 0) {
+            assign(v, v);
+            queue[size++] = v;
+        }
+    }
+    for (int head = 0; head < size; head++) {
+        int u = queue[head];
+        for (int i = 0; i < g.getNeighborCount(u); i++) {
+            int w = g.getNeighbors(u)[i].vertex;
+            if (w != u && inside(w) && --in[w] == 0) {
+                assign(w, w);
+                queue[size++] = w;
+            }
+        }
+        for (int i = 0; i < incoming.getNeighborCount(u); i++) {
+            int w = incoming.getNeighbors(u)[i].vertex;
+            if (w != u && inside(w) && --out[w] == 0) {
+                assign(w, w);
+                queue[size++] = w;
+            }
+        }
+    }
+    int end = lo;
+    for (int k = lo; k < hi; k++) {
+        if (inside(order[k])) order[end++] = order[k];
+    }
+    hi = end;
+    if (lo == hi) return;
+
+    int pivot = order[lo];
+    long long pivotScore = -1;
+    for (int k = lo; k < hi; k++) {
+        int v = order[k];
+        long long score = (long long)in[v] * out[v];
+        if (score > pivotScore) {
+            pivotScore = score;
+            pivot = v;
+        }
+    }
+
+    // bit 1: reached from the pivot, bit 2: reaches the pivot
+    char* mark = scratch.mark;
+    auto reach = [&](const CsrGraph& dir, char bit) {
+        int tail = 0;
+        queue[tail++] = pivot;
+        mark[pivot] |= bit;
+        for (int head = 0; head < tail; head++) {
+            int u = queue[head];
+            for (int i = 0; i < dir.getNeighborCount(u); i++) {
+                int w = dir.getNeighbors(u)[i].vertex;
+                if (inside(w) && (mark[w] & bit) == 0) {
+                    mark[w] |= bit;
+                    queue[tail++] = w;
+                }
+            }
+        }
+    };
+    reach(g, 1);
+    reach(incoming, 2);
+
+    // forward only, backward only and neither, each a new subproblem
+    int count[3] = {0, 0, 0};
+    for (int k = lo; k < hi; k++) {
+        char m = mark[order[k]];
+        if (m != 3) count[m == 0 ? 2 : m - 1]++;
+    }
+    int base = nextColor.fetch_add(3, std::memory_order_relaxed);
+    int start[4] = {0, count[0], count[0] + count[1], count[0] + count[1] + count[2]};
+    int fill[3] = {start[0], start[1], start[2]};
+    for (int k = lo; k < hi; k++) {
+        int v = order[k];
+        char m = mark[v];
+        mark[v] = 0;
+        if (m == 3) {
+            assign(v, pivot);
+            continue;
+        }
+        int part = m == 0 ? 2 : m - 1;
+        color[v].store(base + part, std::memory_order_relaxed);
+        queue[fill[part]++] = v;
+    }
+    for (int k = 0; k < start[3]; k++) order[lo + k] = queue[k];
+    for (int part = 0; part < 3; part++) {
+        if (count[part] > 0) pool.push(lo + start[part], lo + start[part + 1]);
+    }
+}
+
+// Strongly connected components. The parallel engine follows Hong et al.:
+// trim the trivial components, take the vertex with the largest
+// in-degree * out-degree as pivot (most likely inside the giant component),
+// and label everything both reachable from it and reaching it, all of it
+// data parallel. Trim once more, then the rest is recursive FW-BW (Fleischer
+// et al.): the three remainders are subproblems, and threads take them from
+// a shared pool, each trimming, splitting and pushing its pieces back until
+// they are small enough for Tarjan.
+SccResult Algorithms::stronglyConnectedComponents(const CsrGraph& g, SccEngine engine, int numThreads) {
+    const int CHUNK = 1024;
+    const int PARALLEL_ARCS = 1 << 20;
+    int n = g.getNumVertices();
+    SccResult result(n);
+    int threads = parallel::threadCount(numThreads);
+    if (engine == SccEngine::Auto) {
+        engine = threads > 1 && g.getNumArcs() >= PARALLEL_ARCS ? SccEngine::ForwardBackward
+                                                                : SccEngine::Tarjan;
+    }
+
+    if (engine == SccEngine::ForwardBackward && n > 0) {
+        CsrGraph incoming = g.transpose();
+        std::atomic<int>* label = new std::atomic<int>[n];
+        for (int v = 0; v < n; v++) label[v].store(-1, std::memory_order_relaxed);
+        trimScc(g, incoming, label, threads);
+
+        // pivot: per thread best, then the best of those
+        long long* bestScore = new long long[threads];
+        int* bestVertex = new int[threads];
+        parallel::run(threads, [&](int t) {
+            int lo = (int)((long long)n * t / threads);
+            int hi = (int)((long long)n * (t + 1) / threads);
+            bestScore[t] = -1;
+            bestVertex[t] = -1;
+            for (int v = lo; v < hi; v++) {
+                if (label[v].load(std::memory_order_relaxed) != -1) continue;
+                long long score = (long long)g.getNeighborCount(v) * incoming.getNeighborCount(v);
+                if (score > bestScore[t]) {
+                    bestScore[t] = score;
+                    bestVertex[t] = v;
+                }
+            }
+        });
+        int pivot = -1;
+        long long pivotScore = -1;
+        for (int t = 0; t < threads; t++) {
+            if (bestScore[t] > pivotScore) {
+                pivotScore = bestScore[t];
+                pivot = bestVertex[t];
+            }
+        }
+        delete[] bestScore;
+        delete[] bestVertex;
+
+        if (pivot != -1) {
+            std::atomic<char>* mark = new std::atomic<char>[n];
+            int* order = new int[n];
+            parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+                mark[v].store(0, std::memory_order_relaxed);
+            });
+            reachUnlabeled(g, pivot, label, mark, 1, order, threads);
+            reachUnlabeled(incoming, pivot, label, mark, 2, order, threads);
+            parallel::forEach(0, n, threads, CHUNK, [&](int, int v) {
+                if (mark[v].load(std::memory_order_relaxed) == 3) label[v].store(pivot, std::memory_order_relaxed);
+            });
+            trimScc(g, incoming, label, threads);
+
+            // what is left, grouped by the giant step's marks: color 0 is
+            // reached from the pivot only, 1 reaches it only, 2 is neither
+            std::atomic<int>* color = new std::atomic<int>[n];
+            int count[3] = {0, 0, 0};
+            for (int v = 0; v < n; v++) {
+                int part = -1;
+                if (label[v].load(std::memory_order_relaxed) == -1) {
+                    char m = mark[v].load(std::memory_order_relaxed);
+                    part = m == 0 ? 2 : m - 1;
+                    count[part]++;
+                }
+                color[v].store(part, std::memory_order_relaxed);
+            }
+            int start[4] = {0, count[0], count[0] + count[1], count[0] + count[1] + count[2]};
+            int fill[3] = {start[0], start[1], start[2]};
+            for (int v = 0; v < n; v++) {
+                int part = color[v].load(std::memory_order_relaxed);
+                if (part != -1) order[fill[part]++] = v;
+            }
+            delete[] mark;
+
+            parallel::RangePool pool(n);
+            for (int part = 0; part < 3; part++) {
+                if (count[part] > 0) pool.push(start[part], start[part + 1]);
+            }
+            std::atomic<int> nextColor(3);
+            int workers = threads < start[3] ? threads : (start[3] > 0 ? start[3] : 1);
+            parallel::run(workers, [&](int) {
+                SccScratch scratch(n);
+                int lo, hi;
+                while (pool.pop(lo, hi)) {
+                    sccTask(g, incoming, order, lo, hi, color, nextColor, label, scratch, pool);
+                    pool.done();
+                }
+            });
+            delete[] color;
+            delete[] order;
+        }
+
+        for (int v = 0; v < n; v++) result.component[v] = label[v].load(std::memory_order_relaxed);
+        delete[] label;
+    } else {
+        tarjanScc(g, result.component);
+    }
+
+    finishScc(g, result);
+    return result;
+}
+
+SccResult Algorithms::stronglyConnectedComponents(const Graph& g, SccEngine engine, int numThreads) {
+    return stronglyConnectedComponents(g.freeze(), engine, numThreads);
+}
+
+// Arcs into every vertex are bucketed by their head in source order, then
+// each vertex matches its own arcs against its bucket in O(degree).
+void Algorithms::twinArcs(const CsrGraph& g, int* twin) {
+    int n = g.getNumVertices();
+    int m = g.getNumArcs();
+    const int* offs = g.getOffsets();
+    const Neighbor* arcs = g.getNeighbors(0);
+
+    int* start = new int[n + 1];
+    int* incoming = new int[m > 0 ? m : 1];
+    int* source = new int[m > 0 ? m : 1];
+    int* where = new int[n > 0 ? n : 1];
+    int* owner = new int[n > 0 ? n : 1];
+    for (int v = 0; v <= n; v++) start[v] = 0;
+    for (int a = 0; a < m; a++) start[arcs[a].vertex + 1]++;
+    for (int v = 0; v < n; v++) {
+        start[v + 1] += start[v];
+        owner[v] = -1;
+    }
+    int* fill = where;  // reused as insert positions
+    for (int v = 0; v < n; v++) fill[v] = start[v];
+    for (int u = 0; u < n; u++) {
+        for (int a = offs[u]; a < offs[u + 1]; a++) {
+            int v = arcs[a].vertex;
+            source[fill[v]] = u;
+            incoming[fill[v]++] = a;
+        }
+    }
+
+    for (int v = 0; v < n; v++) {
+        for (int a = offs[v]; a < offs[v + 1]; a++) {
+            where[arcs[a].vertex] = a;
+            owner[arcs[a].vertex] = v;
+        }
+        for (int i = start[v]; i < start[v + 1]; i++) {
+            int u = source[i];
+            twin[incoming[i]] = owner[u] == v ? where[u] : -1;
+        }
+    }
+
+    delete[] start;
+    delete[] incoming;
+    delete[] source;
+    delete[] where;
+    delete[] owner;
+}
+
+// Hopcroft-Tarjan low-link DFS with an explicit frame stack. Tree and back
+// arcs go on an arc stack; when a child finishes with low >= the parent's
+// index, the arcs above (and including) its tree arc form one biconnected
+// component and the parent separates it from the rest. The arc back to the
+// parent is skipped by its twin, so parallel edges still count as a cycle.
+BiconnectivityResult Algorithms::biconnectivity(const CsrGraph& g) {
+    int n = g.getNumVertices();
+    int m = g.getNumArcs();
+    BiconnectivityResult result(n, m);
+    const int* offs = g.getOffsets();
+    const Neighbor* arcs = g.getNeighbors(0);
+
+    int* twin = new int[m > 0 ? m : 1];
+    twinArcs(g, twin);
+    int* index = new int[n > 0 ? n : 1];
+    int* low = new int[n > 0 ? n : 1];
+    int* parentArc = new int[n > 0 ? n : 1];
+    DfsFrame* frames = new DfsFrame[n > 0 ? n : 1];
+    Buffer arcStack;
+    for (int v = 0; v < n; v++) index[v] = -1;
+    int counter = 0;
+
+    for (int root = 0; root < n; root++) {
+        if (index[root] != -1) continue;
+        int rootChildren = 0;
+        int top = 0;
+        frames[top++] = {root, 0};
+        index[root] = low[root] = counter++;
+        parentArc[root] = -1;
+
+        while (top > 0) {
+            DfsFrame& frame = frames[top - 1];
+            int v = frame.vertex;
+            if (frame.next < offs[v + 1] - offs[v]) {
+                int a = offs[v] + frame.next++;
+                int w = arcs[a].vertex;
+                if (w == v || (parentArc[v] != -1 && a == twin[parentArc[v]])) continue;
+                if (index[w] == -1) {
+                    arcStack.push(a);
+                    parentArc[w] = a;
+                    index[w] = low[w] = counter++;
+                    frames[top++] = {w, 0};
+                    if (v == root) rootChildren++;
+                } else if (index[w] < index[v]) {
+                    // back arc to an ancestor, its twin is seen from below
+                    arcStack.push(a);
+                    if (index[w] < low[v]) low[v] = index[w];
+                }
+                continue;
+            }
+
+            top--;
+            if (top == 0) break;
+            int p = frames[top - 1].vertex;
+            if (low[v] < low[p]) low[p] = low[v];
+            if (low[v] >= index[p]) {
+                if (p != root) result.articulation[p] = true;
+                int id = result.numComponents++;
+                int a;
+                do {
+                    a = arcStack.data[--arcStack.size];
+                    result.arcComponent[a] = id;
+                    if (twin[a] != -1) result.arcComponent[twin[a]] = id;
+                } while (a != parentArc[v]);
+            }
+            if (low[v] > index[p]) {
+                Edge& bridge = result.bridges[result.bridgeCount++];
+                bridge.u = p;
+                bridge.v = v;
+                bridge.weight = arcs[parentArc[v]].weight;
+            }
+        }
+        if (rootChildren >= 2) result.articulation[root] = true;
+    }
+
+    delete[] twin;
+    delete[] index;
+    delete[] low;
+    delete[] parentArc;
+    delete[] frames;
+    return result;
+}
+
+BiconnectivityResult Algorithms::biconnectivity(const Graph& g) {
+    return biconnectivity(g.freeze());
+}
+
+// Pull-based PageRank. Every iteration first turns ranks into per-arc
+// contributions (rank / out-degree) and sums the rank of dangling vertices
+// in one vector pass, then each vertex adds up the contributions of its
+// in-neighbors. Threads own vertex slices holding about the same number of
+// incoming arcs and meet at a barrier between the phases.
+PageRankResult Algorithms::pageRank(const CsrGraph& g, double damping, double tolerance,
+                                    int maxIterations, int numThreads) {
+    if (damping < 0 || damping >= 1) {
+        throw std::invalid_argument("Damping factor must be in [0, 1)");
+    }
+    if (maxIterations < 1) {
+        throw std::invalid_argument("Iteration limit must be positive");
+    }
+    int n = g.getNumVertices();
+    PageRankResult result(n, maxIterations);
+    if (n == 0) return result;
+    int threads = parallel::threadCount(numThreads);
+    CsrGraph incoming = g.transpose();
+    const int* inOffsets = incoming.getOffsets();
+    const Neighbor* inArcs = incoming.getNeighbors(0);
+
+    double* rank = result.rank;
+    double* next = new double[n];
+    double* contribution = new double[n];
+    double* inverseDegree = new double[n];
+    double* dangling = new double[n];
+    for (int v = 0; v < n; v++) {
+        int degree = g.getNeighborCount(v);
+        inverseDegree[v] = degree > 0 ? 1.0 / degree : 0.0;
+        dangling[v] = degree > 0 ? 0.0 : 1.0;
+    }
+
+    // slice t starts at the first vertex where arcs + vertices passed t/threads
+    int* bound = new int[threads + 1];
+    long long work = (long long)incoming.getNumArcs() + n;
+    for (int t = 0; t <= threads; t++) {
+        long long target = work * t / threads;
+        int lo = 0;
+        int hi = n;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if ((long long)inOffsets[mid] + mid < target) lo = mid + 1;
+            else hi = mid;
+        }
+        bound[t] = lo;
+    }
+
+    double* partial = new double[threads];
+    double base = 0;
+    bool done = false;
+    auto started = std::chrono::steady_clock::now();
+    parallel::Barrier barrier(threads);
+
+    parallel::run(threads, [&](int t) {
+        int lo = bound[t];
+        int hi = bound[t + 1];
+        while (!done) {
+            partial[t] = simd::scaleMasked(rank + lo, inverseDegree + lo, dangling + lo,
+                                           contribution + lo, hi - lo);
+            barrier.wait();
+
+            if (t == 0) {
+                double danglingRank = 0;
+                for (int k = 0; k < threads; k++) danglingRank += partial[k];
+                base = (1.0 - damping) / n + damping * danglingRank / n;
+            }
+            barrier.wait();
+
+            for (int v = lo; v < hi; v++) {
+                double sum = 0;
+                for (int a = inOffsets[v]; a < inOffsets[v + 1]; a++) {
+                    sum += contribution[inArcs[a].vertex];
+                }
+                next[v] = base + damping * sum;
+            }
+            partial[t] = simd::l1Distance(next + lo, rank + lo, hi - lo);
+            barrier.wait();
+
+            if (t == 0) {
+                double residual = 0;
+                for (int k = 0; k < threads; k++) residual += partial[k];
+                double* tmp = rank;
+                rank = next;
+                next = tmp;
+
+                auto now = std::chrono::steady_clock::now();
+                result.iterationSeconds[result.iterations++] = std::chrono::duration<double>(now - started).count();
+                started = now;
+                result.residual = residual;
+                result.converged = residual < tolerance;
+                done = result.converged || result.iterations == maxIterations;
+            }
+            barrier.wait();
+        }
+    });
+
+    // the newest ranks may sit in the scratch array
+    if (rank != result.rank) {
+        for (int v = 0; v < n; v++) result.rank[v] = rank[v];
+        next = rank;
+    }
+
+    delete[] next;
+    delete[] contribution;
+    delete[] inverseDegree;
+    delete[] dangling;
+    delete[] bound;
+    delete[] partial;
+    return result;
+}
+
+PageRankResult Algorithms::pageRank(const Graph& g, double damping, double tolerance,
+                                    int maxIterations, int numThreads) {
+    return pageRank(g.freeze(), damping, tolerance, maxIterations, numThreads);
+}
+
+// Brandes. One search per source counts shortest paths (sigma) in settle
+// order, then walking that order backwards hands every vertex its dependency
+// delta(v) = sum over successors w of sigma(v) / sigma(w) * (1 + delta(w)).
+// Successors are the out-neighbors one hop (or one arc weight) further, so no
+// predecessor lists are kept. Each thread owns its search arrays and score
+// accumulator and only resets the vertices its last search reached; the
+// accumulators are summed at the end.
+BetweennessResult Algorithms::betweenness(const CsrGraph& g, int samples, int numThreads, unsigned seed) {
+    int n = g.getNumVertices();
+    BetweennessResult result(n);
+    if (n == 0) return result;
+    int threads = parallel::threadCount(numThreads);
+
+    const Neighbor* arcs = g.getNeighbors(0);
+    bool weighted = false;
+    int minWeight = INT_MAX;
+    for (int a = 0; a < g.getNumArcs(); a++) {
+        if (arcs[a].weight != arcs[0].weight) weighted = true;
+        if (arcs[a].weight < minWeight) minWeight = arcs[a].weight;
+    }
+    if (weighted && minWeight <= 0) {
+        throw std::invalid_argument("Weighted betweenness needs positive weights");
+    }
+
+    // distinct random sources by a partial Fisher-Yates shuffle
+    int count = samples > 0 && samples < n ? samples : n;
+    int* sources = new int[n];
+    for (int v = 0; v < n; v++) sources[v] = v;
+    if (count < n) {
+        for (int i = 0; i < count; i++) {
+            seed = seed * 1103515245u + 12345u;
+            int j = i + (int)((seed >> 8) % (unsigned)(n - i));
+            int tmp = sources[i];
+            sources[i] = sources[j];
+            sources[j] = tmp;
+        }
+    }
+
+    double** local = new double*[threads];
+    parallel::Barrier barrier(threads);
+    parallel::WorkStealingRange range(threads, 1);
+    range.reset(0, count);
+
+    parallel::run(threads, [&](int t) {
+        double* mine = new double[n];
+        int* dist = new int[n];
+        double* sigma = new double[n];
+        double* delta = new double[n];
+        int* order = new int[n];
+        PriorityQueue pq(weighted ? n : 1);
+        for (int v = 0; v < n; v++) {
+            mine[v] = 0;
+            dist[v] = INT_MAX;
+            sigma[v] = 0;
+            delta[v] = 0;
+        }
+        local[t] = mine;
+
+        int lo, hi;
+        while (range.next(t, lo, hi)) {
+            int s = sources[lo];
+            int reached = 0;
+            dist[s] = 0;
+            sigma[s] = 1;
+            if (!weighted) {
+                order[reached++] = s;
+                for (int head = 0; head < reached; head++) {
+                    int u = order[head];
+                    const Neighbor* neighbors = g.getNeighbors(u);
+                    for (int i = 0; i < g.getNeighborCount(u); i++) {
+                        int w = neighbors[i].vertex;
+                        if (dist[w] == INT_MAX) {
+                            dist[w] = dist[u] + 1;
+                            order[reached++] = w;
+                        }
+                        if (dist[w] == dist[u] + 1) sigma[w] += sigma[u];
+                    }
+                }
+            } else {
+                pq.insert(s, 0);
+                while (!pq.isEmpty()) {
+                    int u = pq.extractMin();
+                    order[reached++] = u;
+                    const Neighbor* neighbors = g.getNeighbors(u);
+                    for (int i = 0; i < g.getNeighborCount(u); i++) {
+                        int w = neighbors[i].vertex;
+                        int d = dist[u] + neighbors[i].weight;
+                        if (d < dist[w]) {
+                            dist[w] = d;
+                            sigma[w] = sigma[u];
+                            pq.insert(w, d);
+                        } else if (d == dist[w]) {
+                            sigma[w] += sigma[u];
+                        }
+                    }
+                }
+            }
+
+            for (int i = reached - 1; i >= 0; i--) {
+                int v = order[i];
+                const Neighbor* neighbors = g.getNeighbors(v);
+                for (int j = 0; j < g.getNeighborCount(v); j++) {
+                    int w = neighbors[j].vertex;
+                    int step = weighted ? neighbors[j].weight : 1;
+                    if (dist[w] == dist[v] + step) delta[v] += sigma[v] / sigma[w] * (1.0 + delta[w]);
+                }
+                if (v != s) mine[v] += delta[v];
+            }
+            for (int i = 0; i < reached; i++) {
+                int v = order[i];
+                dist[v] = INT_MAX;
+                sigma[v] = 0;
+                delta[v] = 0;
+            }
+        }
+
+        // every thread sums one slice of the accumulators
+        barrier.wait();
+        double scale = (double)n / count;
+        int first = (int)((long long)n * t / threads);
+        int last = (int)((long long)n * (t + 1) / threads);
+        for (int v = first; v < last; v++) {
+            double sum = 0;
+            for (int k = 0; k < threads; k++) sum += local[k][v];
+            result.score[v] = sum * scale;
+        }
+        barrier.wait();
+
+        delete[] mine;
+        delete[] dist;
+        delete[] sigma;
+        delete[] delta;
+        delete[] order;
+    });
+
+    // a sampled source contributes delta / (n - 1) in [0, 1] to the
+    // normalized score, Hoeffding plus a union bound over all vertices
+    result.sourcesUsed = count;
+    if (count < n) {
+        double eps = std::sqrt(std::log(2.0 * n / 0.05) / (2.0 * count));
+        result.errorBound = eps * n * (n - 1.0);
+    }
+
+    delete[] sources;
+    delete[] local;
+    return result;
+}
+
+BetweennessResult Algorithms::betweenness(const Graph& g, int samples, int numThreads, unsigned seed) {
+    return betweenness(g.freeze(), samples, numThreads, seed);
+}
+
+// Triangle counting on a degree-ordered orientation. Vertices are renamed by
+// (degree, id) and every edge points from the lower to the higher name, so
+// each triangle x < y < z is found exactly once, as z in both out(x) and
+// out(y), and no out-list is longer than about sqrt(2m). Filling the lists
+// in order of the target name leaves them sorted without a sort, ready for
+// the merge intersection in Simd.hpp.
+TriangleResult Algorithms::countTriangles(const CsrGraph& g, int numThreads) {
+    const int CHUNK = 64;
+    int n = g.getNumVertices();
+    TriangleResult result(n);
+    if (n == 0) return result;
+    int threads = parallel::threadCount(numThreads);
+
+    // counting sort by degree gives the new names
+    int maxDegree = 0;
+    for (int v = 0; v < n; v++) {
+        if (g.getNeighborCount(v) > maxDegree) maxDegree = g.getNeighborCount(v);
+    }
+    int* bucket = new int[maxDegree + 2];
+    for (int d = 0; d <= maxDegree + 1; d++) bucket[d] = 0;
+    for (int v = 0; v < n; v++) bucket[g.getNeighborCount(v) + 1]++;
+    for (int d = 0; d <= maxDegree; d++) bucket[d + 1] += bucket[d];
+    int* name = new int[n];
+    int* original = new int[n];
+    for (int v = 0; v < n; v++) {
+        int x = bucket[g.getNeighborCount(v)]++;
+        name[v] = x;
+        original[x] = v;
+    }
+    delete[] bucket;
+
+    // oriented lists: count, then fill from the target side
+    int* offs = new int[n + 1];
+    parallel::forEach(0, n, threads, CHUNK * 16, [&](int, int x) {
+        int v = original[x];
+        const Neighbor* neighbors = g.getNeighbors(v);
+        int higher = 0;
+        for (int i = 0; i < g.getNeighborCount(v); i++) {
+            if (name[neighbors[i].vertex] > x) higher++;
+        }
+        offs[x + 1] = higher;
+    });
+    offs[0] = 0;
+    for (int x = 0; x < n; x++) offs[x + 1] += offs[x];
+    int* out = new int[offs[n] > 0 ? offs[n] : 1];
+    int* fill = new int[n];
+    for (int x = 0; x < n; x++) fill[x] = offs[x];
+    for (int y = 0; y < n; y++) {
+        int v = original[y];
+        const Neighbor* neighbors = g.getNeighbors(v);
+        for (int i = 0; i < g.getNeighborCount(v); i++) {
+            int x = name[neighbors[i].vertex];
+            if (x < y) out[fill[x]++] = y;
+        }
+    }
+    delete[] fill;
+
+    std::atomic<long long>* count = new std::atomic<long long>[n];
+    for (int x = 0; x < n; x++) count[x].store(0, std::memory_order_relaxed);
+    std::atomic<long long> total(0);
+
+    parallel::forEach(0, n, threads, CHUNK, [&](int, int x) {
+        long long found = 0;
+        for (int i = offs[x]; i < offs[x + 1]; i++) {
+            int y = out[i];
+            long long before = found;
+            simd::intersect(out + i + 1, offs[x + 1] - i - 1, out + offs[y], offs[y + 1] - offs[y],
+                            [&](int z) {
+                                found++;
+                                count[z].fetch_add(1, std::memory_order_relaxed);
+                            });
+            if (found > before) count[y].fetch_add(found - before, std::memory_order_relaxed);
+        }
+        if (found > 0) {
+            count[x].fetch_add(found, std::memory_order_relaxed);
+            total.fetch_add(found, std::memory_order_relaxed);
+        }
+    });
+
+    result.total = total.load();
+    parallel::forEach(0, n, threads, CHUNK * 16, [&](int, int v) {
+        long long triangles = count[name[v]].load(std::memory_order_relaxed);
+        long long degree = g.getNeighborCount(v);
+        result.perVertex[v] = triangles;
+        result.clustering[v] = degree < 2 ? 0.0 : 2.0 * triangles / (degree * (degree - 1));
+    });
+
+    delete[] name;
+    delete[] original;
+    delete[] offs;
+    delete[] out;
+    delete[] count;
+    return result;
+}
+
+TriangleResult Algorithms::countTriangles(const Graph& g, int numThreads) {
+    return countTriangles(g.freeze(), numThreads);
+}
+
+// Batagelj-Zaversnik. Vertices sit in one array sorted by current degree,
+// bin[d] is where degree d starts. Taking vertices in that order, every
+// neighbor with a higher degree swaps to the front of its bin, and the bin
+// boundary moves past it, which lowers its degree by one in O(1).
+template <typename G>
+void Algorithms::coreBucketImpl(const G& g, CoreResult& result) {
+    int n = g.getNumVertices();
+    int* degree = result.core;
+    int maxDegree = 0;
+    for (int v = 0; v < n; v++) {
+        degree[v] = g.getNeighborCount(v);
+        if (degree[v] > maxDegree) maxDegree = degree[v];
+    }
+
+    int* bin = new int[maxDegree + 1];
+    int* vert = new int[n];
+    int* pos = new int[n];
+    for (int d = 0; d <= maxDegree; d++) bin[d] = 0;
+    for (int v = 0; v < n; v++) bin[degree[v]]++;
+    int start = 0;
+    for (int d = 0; d <= maxDegree; d++) {
+        int size = bin[d];
+        bin[d] = start;
+        start += size;
+    }
+    for (int v = 0; v < n; v++) {
+        pos[v] = bin[degree[v]]++;
+        vert[pos[v]] = v;
+    }
+    for (int d = maxDegree; d > 0; d--) bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    for (int i = 0; i < n; i++) {
+        int v = vert[i];
+        const Neighbor* neighbors = g.getNeighbors(v);
+        int neighborCount = g.getNeighborCount(v);
+        for (int j = 0; j < neighborCount; j++) {
+            int u = neighbors[j].vertex;
+            if (degree[u] <= degree[v]) continue;
+            int du = degree[u];
+            int pu = pos[u];
+            int pw = bin[du];
+            int w = vert[pw];
+            if (u != w) {
+                pos[u] = pw;
+                vert[pu] = w;
+                pos[w] = pu;
+                vert[pw] = u;
+            }
+            bin[du]++;
+            degree[u]--;
+        }
+    }
+
+    result.maxCore = 0;
+    for (int v = 0; v < n; v++) {
+        if (degree[v] > result.maxCore) result.maxCore = degree[v];
+    }
+    delete[] bin;
+    delete[] vert;
+    delete[] pos;
+}
+
+// Parallel peeling, level k at a time. A pass over the vertices still left
+// claims every one with degree <= k (its core is k) and drops the claimed
+// ones from the list. The claimed vertices are swept like a BFS frontier:
+// neighbors lose one degree, never going below k, and whoever brings one down
+// to exactly k claims it for this level too. An empty level jumps k straight
+// to the smallest degree left.
+CoreResult Algorithms::coreNumbers(const CsrGraph& g, CoreEngine engine, int numThreads) {
+    const int PARALLEL_ARCS = 1 << 20;
+    int n = g.getNumVertices();
+    CoreResult result(n);
+    int threads = parallel::threadCount(numThreads);
+    if (engine == CoreEngine::Auto) {
+        engine = threads > 1 && g.getNumArcs() >= PARALLEL_ARCS ? CoreEngine::ParallelPeel : CoreEngine::Bucket;
+    }
+    if (engine == CoreEngine::Bucket || n == 0) {
+        coreBucketImpl(g, result);
+        return result;
+    }
+
+    std::atomic<int>* degree = new std::atomic<int>[n];
+    std::atomic<int>* core = new std::atomic<int>[n];
+    int* left = new int[n];
+    int* spare = new int[n];
+    int* queue = new int[n];
+    int* kept = new int[threads + 1];
+    int* claimed = new int[threads + 1];
+    int* smallest = new int[threads];
+    for (int v = 0; v < n; v++) {
+        degree[v].store(g.getNeighborCount(v), std::memory_order_relaxed);
+        core[v].store(-1, std::memory_order_relaxed);
+        left[v] = v;
+    }
+    int leftCount = n;
+    int k = 0;
+
+    while (leftCount > 0) {
+        // claim this level's vertices and keep the rest, in slice order
+        parallel::run(threads, [&](int t) {
+            int lo = (int)((long long)leftCount * t / threads);
+            int hi = (int)((long long)leftCount * (t + 1) / threads);
+            int keep = 0, take = 0, least = INT_MAX;
+            for (int i = lo; i < hi; i++) {
+                int v = left[i];
+                if (core[v].load(std::memory_order_relaxed) != -1) continue;
+                int d = degree[v].load(std::memory_order_relaxed);
+                if (d <= k) take++;
+                else {
+                    keep++;
+                    if (d < least) least = d;
+                }
+            }
+            kept[t + 1] = keep;
+            claimed[t + 1] = take;
+            smallest[t] = least;
+        });
+        kept[0] = 0;
+        claimed[0] = 0;
+        int least = INT_MAX;
+        for (int t = 0; t < threads; t++) {
+            kept[t + 1] += kept[t];
+            claimed[t + 1] += claimed[t];
+            if (smallest[t] < least) least = smallest[t];
+        }
+        int frontier = claimed[threads];
+        if (frontier == 0) {
+            // the last sweep may have claimed everything that was left
+            if (kept[threads] == 0) break;
+            k = least;
+            continue;
+        }
+        parallel::run(threads, [&](int t) {
+            int lo = (int)((long long)leftCount * t / threads);
+            int hi = (int)((long long)leftCount * (t + 1) / threads);
+            int keep = kept[t], take = claimed[t];
+            for (int i = lo; i < hi; i++) {
+                int v = left[i];
+                if (core[v].load(std::memory_order_relaxed) != -1) continue;
+                if (degree[v].load(std::memory_order_relaxed) <= k) {
+                    core[v].store(k, std::memory_order_relaxed);
+                    queue[take++] = v;
+                } else {
+                    spare[keep++] = v;
+                }
+            }
+        });
+        int* tmp = left;
+        left = spare;
+        spare = tmp;
+        leftCount = kept[threads];
+
+        sweepFrontier(queue, frontier, threads, [&](int v, Buffer& out) {
+            const Neighbor* neighbors = g.getNeighbors(v);
+            for (int i = 0; i < g.getNeighborCount(v); i++) {
+                int u = neighbors[i].vertex;
+                if (core[u].load(std::memory_order_relaxed) != -1) continue;
+                int d = degree[u].load(std::memory_order_relaxed);
+                while (d > k && !degree[u].compare_exchange_weak(d, d - 1, std::memory_order_relaxed)) {
+                }
+                int unclaimed = -1;
+                if (d == k + 1 && core[u].compare_exchange_strong(unclaimed, k, std::memory_order_relaxed)) {
+                    out.push(u);
+                }
+            }
+        });
+        k++;
+    }
+
+    for (int v = 0; v < n; v++) {
+        result.core[v] = core[v].load(std::memory_order_relaxed);
+        if (result.core[v] > result.maxCore) result.maxCore = result.core[v];
+    }
+    delete[] degree;
+    delete[] core;
+    delete[] left;
+    delete[] spare;
+    delete[] queue;
+    delete[] kept;
+    delete[] claimed;
+    delete[] smallest;
+    return result;
+}
+
+CoreResult Algorithms::coreNumbers(const Graph& g, CoreEngine engine, int numThreads) {
+    return coreNumbers(g.freeze(), engine, numThreads);
+}
+
+// Vertex-parallel local moves. Every vertex sums its arc weights per
+// neighboring community in its thread's table and joins the community with
+// the best modularity gain w(v, c) - k(v) * tot(c) / 2m. Community totals and
+// sizes are atomics, so moves made by other threads are seen right away. Two
+// singletons only merge towards the smaller id, otherwise they could keep
+// swapping places forever. Sweeps repeat until one gains < tolerance.
+bool Algorithms::louvainMoves(const LevelGraph& h, int* comm, int threads, double tolerance) {
+    const int CHUNK = 256;
+    const int MAX_SWEEPS = 50;
+    int n = h.numVertices;
+    long long* strength = new long long[n];
+    std::atomic<int>* community = new std::atomic<int>[n];
+    std::atomic<long long>* total = new std::atomic<long long>[n];
+    std::atomic<int>* size = new std::atomic<int>[n];
+    long long twiceM = 0;
+    for (int v = 0; v < n; v++) {
+        strength[v] = 0;
+        for (int a = h.offsets[v]; a < h.offsets[v + 1]; a++) strength[v] += h.weights[a];
+        twiceM += strength[v];
+        community[v].store(v, std::memory_order_relaxed);
+        total[v].store(strength[v], std::memory_order_relaxed);
+        size[v].store(1, std::memory_order_relaxed);
+    }
+
+    WeightTable* tables = new WeightTable[threads];
+    long long* moved = new long long[threads];
+    double* inside = new double[threads];
+    bool movedAny = false;
+    double quality = -1;
+
+    for (int sweep = 0; sweep < MAX_SWEEPS && twiceM > 0; sweep++) {
+        for (int t = 0; t < threads; t++) moved[t] = 0;
+        parallel::forEach(0, n, threads, CHUNK, [&](int t, int v) {
+            WeightTable& table = tables[t];
+            table.clear();
+            int from = community[v].load(std::memory_order_relaxed);
+            for (int a = h.offsets[v]; a < h.offsets[v + 1]; a++) {
+                int u = h.targets[a];
+                if (u != v) table.add(community[u].load(std::memory_order_relaxed), h.weights[a]);
+            }
+
+            double k = (double)strength[v];
+            double stay = table.get(from) -
+                          k * (total[from].load(std::memory_order_relaxed) - strength[v]) / twiceM;
+            int best = from;
+            double bestGain = stay;
+            bool alone = size[from].load(std::memory_order_relaxed) == 1;
+            for (int i = 0; i < table.usedCount; i++) {
+                int c = table.keys[table.used[i]];
+                if (c == from) continue;
+                if (alone && c > from && size[c].load(std::memory_order_relaxed) == 1) continue;
+                double gain = table.values[table.used[i]] - k * total[c].load(std::memory_order_relaxed) / twiceM;
+                if (gain > bestGain || (gain == bestGain && best != from && c < best)) {
+                    bestGain = gain;
+                    best = c;
+                }
+            }
+            if (best != from && bestGain > stay) {
+                community[v].store(best, std::memory_order_relaxed);
+                total[from].fetch_sub(strength[v], std::memory_order_relaxed);
+                total[best].fetch_add(strength[v], std::memory_order_relaxed);
+                size[from].fetch_sub(1, std::memory_order_relaxed);
+                size[best].fetch_add(1, std::memory_order_relaxed);
+                moved[t]++;
+            }
+        });
+
+        long long moves = 0;
+        for (int t = 0; t < threads; t++) moves += moved[t];
+        if (moves == 0) break;
+        movedAny = true;
+
+        // modularity after this sweep
+        for (int t = 0; t < threads; t++) inside[t] = 0;
+        parallel::forEach(0, n, threads, CHUNK, [&](int t, int v) {
+            int c = community[v].load(std::memory_order_relaxed);
+            long long sum = 0;
+            for (int a = h.offsets[v]; a < h.offsets[v + 1]; a++) {
+                if (community[h.targets[a]].load(std::memory_order_relaxed) == c) sum += h.weights[a];
+            }
+            double tot = (double)total[v].load(std::memory_order_relaxed) / twiceM;
+            inside[t] += (double)sum / twiceM - tot * tot;
+        });
+        double q = 0;
+        for (int t = 0; t < threads; t++) q += inside[t];
+        if (q - quality < tolerance) break;
+        quality = q;
+    }
+
+    for (int v = 0; v < n; v++) comm[v] = community[v].load(std::memory_order_relaxed);
+    delete[] strength;
+    delete[] community;
+    delete[] total;
+    delete[] size;
+    delete[] tables;
+    delete[] moved;
+    delete[] inside;
+    return movedAny;
+}
+
+// Members of every community are grouped, then each community merges its
+// members' arcs by target community in a thread-local table: once to count
+// the distinct targets, once to write them. Arcs inside the community add up
+// to its self loop.
+Algorithms::LevelGraph* Algorithms::louvainAggregate(const LevelGraph& h, const int* comm, int k, int threads) {
+    const int CHUNK = 64;
+    int n = h.numVertices;
+    int* start = new int[k + 1];
+    int* members = new int[n > 0 ? n : 1];
+    for (int c = 0; c <= k; c++) start[c] = 0;
+    for (int v = 0; v < n; v++) start[comm[v] + 1]++;
+    for (int c = 0; c < k; c++) start[c + 1] += start[c];
+    int* fill = new int[k > 0 ? k : 1];
+    for (int c = 0; c < k; c++) fill[c] = start[c];
+    for (int v = 0; v < n; v++) members[fill[comm[v]]++] = v;
+    delete[] fill;
+
+    WeightTable* tables = new WeightTable[threads];
+    auto gather = [&](WeightTable& table, int c) {
+        table.clear();
+        for (int m = start[c]; m < start[c + 1]; m++) {
+            int v = members[m];
+            for (int a = h.offsets[v]; a < h.offsets[v + 1]; a++) {
+                table.add(comm[h.targets[a]], h.weights[a]);
+            }
+        }
+    };
+
+    int* offs = new int[k + 1];
+    parallel::forEach(0, k, threads, CHUNK, [&](int t, int c) {
+        gather(tables[t], c);
+        offs[c + 1] = tables[t].usedCount;
+    });
+    offs[0] = 0;
+    for (int c = 0; c < k; c++) offs[c + 1] += offs[c];
+    int* targets = new int[offs[k] > 0 ? offs[k] : 1];
+    long long* weights = new long long[offs[k] > 0 ? offs[k] : 1];
+    parallel::forEach(0, k, threads, CHUNK, [&](int t, int c) {
+        WeightTable& table = tables[t];
+        gather(table, c);
+        for (int i = 0; i < table.usedCount; i++) {
+            targets[offs[c] + i] = table.keys[table.used[i]];
+            weights[offs[c] + i] = table.values[table.used[i]];
+        }
+    });
+
+    delete[] start;
+    delete[] members;
+    delete[] tables;
+    return new LevelGraph(k, offs, targets, weights);
+}
+
+// Louvain (Blondel et al.) with parallel local moves: move vertices between
+// communities while modularity improves, shrink every community into one
+// vertex, and repeat on the smaller graph until nothing moves.
+CommunityResult Algorithms::louvain(const CsrGraph& g, int numThreads, double tolerance, int maxLevels) {
+    int n = g.getNumVertices();
+    CommunityResult result(n);
+    int m = g.getNumArcs();
+    const Neighbor* arcs = g.getNeighbors(0);
+    for (int a = 0; a < m; a++) {
+        if (arcs[a].weight < 0) {
+            throw std::invalid_argument("Modularity needs non-negative weights");
+        }
+    }
+    if (n == 0) return result;
+    int threads = parallel::threadCount(numThreads);
+
+    // level 0 is the input made symmetric with 64-bit weights: u and v are
+    // joined by w(u, v) + w(v, u), merged from the out and in lists of u
+    CsrGraph incoming = g.transpose();
+    const CsrGraph* sides[2] = {&g, &incoming};
+    int* offs = new int[n + 1];
+    int* targets = new int[m > 0 ? 2 * m : 1];
+    long long* weights = new long long[m > 0 ? 2 * m : 1];
+    int* slot = new int[n];
+    for (int v = 0; v < n; v++) slot[v] = -1;
+    offs[0] = 0;
+    for (int u = 0; u < n; u++) {
+        int count = offs[u];
+        for (const CsrGraph* side : sides) {
+            const Neighbor* neighbors = side->getNeighbors(u);
+            for (int i = 0; i < side->getNeighborCount(u); i++) {
+                int v = neighbors[i].vertex;
+                if (slot[v] == -1) {
+                    slot[v] = count;
+                    targets[count] = v;
+                    weights[count++] = 0;
+                }
+                weights[slot[v]] += neighbors[i].weight;
+            }
+        }
+        offs[u + 1] = count;
+        for (int a = offs[u]; a < count; a++) slot[targets[a]] = -1;
+    }
+    delete[] slot;
+    LevelGraph* level = new LevelGraph(n, offs, targets, weights);
+    int* mapping = result.community;
+
+    for (int round = 0; round < maxLevels; round++) {
+        int size = level->numVertices;
+        int* comm = new int[size];
+        if (!louvainMoves(*level, comm, threads, tolerance)) {
+            delete[] comm;
+            break;
+        }
+
+        // compact ids, then every input vertex follows its community
+        int* id = new int[size];
+        for (int c = 0; c < size; c++) id[c] = -1;
+        int k = 0;
+        for (int v = 0; v < size; v++) {
+            if (id[comm[v]] == -1) id[comm[v]] = k++;
+            comm[v] = id[comm[v]];
+        }
+        delete[] id;
+        parallel::forEach(0, n, threads, 1024, [&](int, int v) {
+            mapping[v] = comm[mapping[v]];
+        });
+        result.numCommunities = k;
+        result.levels++;
+
+        if (k == size) {
+            delete[] comm;
+            break;
+        }
+        LevelGraph* next = louvainAggregate(*level, comm, k, threads);
+        delete[] comm;
+        delete level;
+        level = next;
+    }
+    delete level;
+
+    // modularity of the final partition on the input graph
+    long long twiceM = 0;
+    long long* inside = new long long[result.numCommunities];
+    long long* total = new long long[result.numCommunities];
+    for (int c = 0; c < result.numCommunities; c++) {
+        inside[c] = 0;
+        total[c] = 0;
+    }
+    for (int v = 0; v < n; v++) {
+        int c = mapping[v];
+        for (const CsrGraph* side : sides) {
+            const Neighbor* neighbors = side->getNeighbors(v);
+            for (int i = 0; i < side->getNeighborCount(v); i++) {
+                twiceM += neighbors[i].weight;
+                total[c] += neighbors[i].weight;
+                if (mapping[neighbors[i].vertex] == c) inside[c] += neighbors[i].weight;
+            }
+        }
+    }
+    result.modularity = 0;
+    if (twiceM > 0) {
+        for (int c = 0; c < result.numCommunities; c++) {
+            double tot = (double)total[c] / twiceM;
+            result.modularity += (double)inside[c] / twiceM - tot * tot;
+        }
+    }
+    delete[] inside;
+    delete[] total;
+    return result;
+}
+
+CommunityResult Algorithms::louvain(const Graph& g, int numThreads, double tolerance, int maxLevels) {
+    return louvain(g.freeze(), numThreads, tolerance, maxLevels);
+}
+
+// Forward push. Every vertex holds an estimate p and a residual r, starting
+// with r = 1 at the seed. Pushing u moves alpha * r(u) into p(u) and spreads
+// the rest evenly over its out-neighbors. Only vertices with
+// r(u) >= epsilon * deg(u) are pushed, so the total work is
+// O(1 / (alpha * epsilon)) whatever the size of the graph.
+template <typename G>
+void Algorithms::pprImpl(const G& g, int seed, PprWorkspace& ws, double alpha, double epsilon) {
+    int n = g.getNumVertices();
+    if (seed < 0 || seed >= n) {
+        throw std::invalid_argument("Seed vertex out of bounds");
+    }
+    if (ws.numVertices != n) {
+        throw std::invalid_argument("Workspace belongs to a graph of a different size");
+    }
+    if (alpha <= 0 || alpha > 1 || epsilon <= 0) {
+        throw std::invalid_argument("alpha must be in (0, 1] and epsilon positive");
+    }
+    ws.clear();
+
+    auto touch = [&](int v) {
+        if (ws.estimate[v] == 0 && ws.residual[v] == 0 && !ws.queued[v]) ws.touched[ws.touchedCount++] = v;
+    };
+    // the ring never overflows, a vertex is in it at most once
+    int head = 0;
+    int size = 0;
+    auto enqueue = [&](int v) {
+        ws.queued[v] = true;
+        ws.queue[(head + size++) % n] = v;
+    };
+    auto overThreshold = [&](int v) {
+        int degree = g.getNeighborCount(v);
+        return ws.residual[v] >= epsilon * (degree > 0 ? degree : 1);
+    };
+
+    touch(seed);
+    ws.residual[seed] = 1.0;
+    enqueue(seed);
+
+    while (size > 0) {
+        int u = ws.queue[head];
+        head = (head + 1) % n;
+        size--;
+        ws.queued[u] = false;
+
+        int degree = g.getNeighborCount(u);
+        double r = ws.residual[u];
+        ws.estimate[u] += alpha * r;
+        ws.residual[u] = 0;
+        double rest = (1.0 - alpha) * r;
+
+        if (degree == 0) {
+            ws.residual[seed] += rest;
+            if (!ws.queued[seed] && overThreshold(seed)) enqueue(seed);
+            continue;
+        }
+        double share = rest / degree;
+        const Neighbor* neighbors = g.getNeighbors(u);
+        for (int i = 0; i < degree; i++) {
+            int v = neighbors[i].vertex;
+            touch(v);
+            ws.residual[v] += share;
+            if (!ws.queued[v] && overThreshold(v)) enqueue(v);
+        }
+    }
+}
+
+TraversalResult Algorithms::bfs(const Graph& g, int source) { return bfsImpl(g, source); }
+DfsResult Algorithms::dfs(const Graph& g, int source) { return dfsImpl(g, source); }
+DfsResult Algorithms::dfsForest(const Graph& g) { return dfsForestImpl(g); }
+ShortestPathResult Algorithms::dijkstra(const Graph& g, int source) { return dijkstraImpl(g, source); }
+ShortestPathResult Algorithms::dial(const Graph& g, int source) { return dialAuto(g, source); }
+ShortestPathResult Algorithms::dijkstraHeap(const Graph& g, int source) { return heapDijkstraImpl(g, source); }
+SpanningForest Algorithms::prim(const Graph& g) { return primImpl(g); }
+SpanningForest Algorithms::kruskal(const Graph& g) { return kruskalImpl(g); }
+void Algorithms::personalizedPageRank(const Graph& g, int seed, PprWorkspace& ws, double alpha, double epsilon) {
+    pprImpl(g, seed, ws, alpha, epsilon);
+}
+
+TraversalResult Algorithms::bfs(const CsrGraph& g, int source) { return bfsImpl(g, source); }
+DfsResult Algorithms::dfs(const CsrGraph& g, int source) { return dfsImpl(g, source); }
+DfsResult Algorithms::dfsForest(const CsrGraph& g) { return dfsForestImpl(g); }
+ShortestPathResult Algorithms::dijkstra(const CsrGraph& g, int source) { return dijkstraImpl(g, source); }
+ShortestPathResult Algorithms::dial(const CsrGraph& g, int source) { return dialAuto(g, source); }
+ShortestPathResult Algorithms::dijkstraHeap(const CsrGraph& g, int source) { return heapDijkstraImpl(g, source); }
+SpanningForest Algorithms::prim(const CsrGraph& g) { return primImpl(g); }
+SpanningForest Algorithms::kruskal(const CsrGraph& g) { return kruskalImpl(g); }
+void Algorithms::personalizedPageRank(const CsrGraph& g, int seed, PprWorkspace& ws, double alpha, double epsilon) {
+    pprImpl(g, seed, ws, alpha, epsilon);
+}
+
+} // namespace graph
@@ -0,0 +1,382 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * ContractionHierarchy.cpp - Implementation of the ContractionHierarchy class
+ */
+
+#include "../include/ContractionHierarchy.hpp"
+#include <climits>  // For INT_MAX
+#include <fstream>
+#include <stdexcept>
+
+namespace graph {
+
+static const char FILE_MAGIC[4] = {'G', 'C', 'H', '1'};
+
+ContractionHierarchy::ContractionHierarchy(int vertices, int* ranks, int* offs, ChArc* list)
+    : numVertices(vertices), numArcs(offs[vertices]), rank(ranks), offsets(offs), arcs(list) {}
+
+ContractionHierarchy::~ContractionHierarchy() {
+    delete[] rank;
+    delete[] offsets;
+    delete[] arcs;
+}
+
+// Move constructor
+ContractionHierarchy::ContractionHierarchy(ContractionHierarchy&& other) noexcept
+    : numVertices(other.numVertices),
+      numArcs(other.numArcs),
+      rank(other.rank),
+      offsets(other.offsets),
+      arcs(other.arcs) {
+    // Invalidate the other object
+    other.numVertices = 0;
+    other.numArcs = 0;
+    other.rank = nullptr;
+    other.offsets = nullptr;
+    other.arcs = nullptr;
+}
+
+// Move assignment operator
+ContractionHierarchy& ContractionHierarchy::operator=(ContractionHierarchy&& other) noexcept {
+    if (this != &other) {
+        // Clean up current resources
+        delete[] rank;
+        delete[] offsets;
+        delete[] arcs;
+
+        // Move resources from other
+        numVertices = other.numVertices;
+        numArcs = other.numArcs;
+        rank = other.rank;
+        offsets = other.offsets;
+        arcs = other.arcs;
+
+        // Invalidate the other object
+        other.numVertices = 0;
+        other.numArcs = 0;
+        other.rank = nullptr;
+        other.offsets = nullptr;
+        other.arcs = nullptr;
+    }
+    return *this;
+}
+
+const ChArc* ContractionHierarchy::findUpArc(int lower, int higher) const {
+    for (int i = offsets[lower]; i < offsets[lower + 1]; i++) {
+        if (arcs[i].vertex == higher) return &arcs[i];
+    }
+    return nullptr;
+}
+
+// layout: magic, vertex count, arc count, ranks, offsets, then the arcs
+void ContractionHierarchy::save(const char* path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing");
+    }
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&numVertices), sizeof(int));
+    out.write(reinterpret_cast<const char*>(&numArcs), sizeof(int));
+    out.write(reinterpret_cast<const char*>(rank), (std::streamsize)sizeof(int) * numVertices);
+    out.write(reinterpret_cast<const char*>(offsets), (std::streamsize)sizeof(int) * (numVertices + 1));
+    for (int i = 0; i < numArcs; i++) {
+        int fields[3] = {arcs[i].vertex, arcs[i].weight, arcs[i].middle};
+        out.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write contraction hierarchy");
+    }
+}
+
+ContractionHierarchy ContractionHierarchy::load(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open file for reading");
+    }
+    char magic[4];
+    int vertices = 0, arcCount = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&vertices), sizeof(int));
+    in.read(reinterpret_cast<char*>(&arcCount), sizeof(int));
+    if (!in || magic[0] != FILE_MAGIC[0] || magic[1] != FILE_MAGIC[1] ||
+        magic[2] != FILE_MAGIC[2] || magic[3] != FILE_MAGIC[3] || vertices < 0 || arcCount < 0) {
+        throw std::runtime_error("Not a contraction hierarchy file");
+    }
+
+    int* ranks = new int[vertices > 0 ? vertices : 1];
+    int* offs = new int[vertices + 1];
+    ChArc* list = new ChArc[arcCount > 0 ? arcCount : 1];
+    in.read(reinterpret_cast<char*>(ranks), (std::streamsize)sizeof(int) * vertices);
+    in.read(reinterpret_cast<char*>(offs), (std::streamsize)sizeof(int) * (vertices + 1));
+    for (int i = 0; i < arcCount && in; i++) {
+        int fields[3];
+        in.read(reinterpret_cast<char*>(fields), sizeof(fields));
+        list[i] = ChArc(fields[0], fields[1], fields[2]);
+    }
+    if (!in || offs[vertices] != arcCount) {
+        delete[] ranks;
+        delete[] offs;
+        delete[] list;
+        throw std::runtime_error("Truncated contraction hierarchy file");
+    }
+    if (!validLayout(vertices, ranks, offs, list)) {
+        delete[] ranks;
+        delete[] offs;
+        delete[] list;
+        throw std::runtime_error("Corrupt contraction hierarchy file");
+    }
+    return ContractionHierarchy(vertices, ranks, offs, list);
+}
+
+// offsets never decrease, ranks are a permutation, every arc leads to a
+// higher ranked vertex and every shortcut skips a lower ranked one, which is
+// what the queries and the unpacking rely on
+bool ContractionHierarchy::validLayout(int vertices, const int* ranks, const int* offs, const ChArc* list) {
+    if (offs[0] != 0) return false;
+    for (int v = 0; v < vertices; v++) {
+        if (offs[v + 1] < offs[v]) return false;
+    }
+
+    bool* seen = new bool[vertices > 0 ? vertices : 1]();
+    bool valid = true;
+    for (int v = 0; v < vertices && valid; v++) {
+        if (ranks[v] < 0 || ranks[v] >= vertices || seen[ranks[v]]) valid = false;
+        else seen[ranks[v]] = true;
+    }
+    delete[] seen;
+
+    for (int u = 0; u < vertices && valid; u++) {
+        for (int i = offs[u]; i < offs[u + 1]; i++) {
+            int v = list[i].vertex;
+            int m = list[i].middle;
+            if (v < 0 || v >= vertices || ranks[v] <= ranks[u] ||
+                m < -1 || m >= vertices || (m != -1 && ranks[m] >= ranks[u])) {
+                valid = false;
+                break;
+            }
+        }
+    }
+    return valid;
+}
+
+// ChQuery implementation
+ChQuery::ChQuery(const ContractionHierarchy& hierarchy) : ch(hierarchy), touchedCount(0) {
+    int n = ch.getNumVertices();
+    for (int side = 0; side < 2; side++) {
+        dist[side] = new int[n > 0 ? n : 1];
+        parent[side] = new int[n > 0 ? n : 1];
+        middle[side] = new int[n > 0 ? n : 1];
+        for (int v = 0; v < n; v++) {
+            dist[side][v] = INT_MAX;
+        }
+        heapCapacity[side] = 64;
+        heapSize[side] = 0;
+        heap[side] = new HeapItem[heapCapacity[side]];
+    }
+    touched = new int[n > 0 ? n : 1];
+    unpackCapacity = 64;
+    unpackStack = new int[unpackCapacity];
+}
+
+ChQuery::~ChQuery() {
+    for (int side = 0; side < 2; side++) {
+        delete[] dist[side];
+        delete[] parent[side];
+        delete[] middle[side];
+        delete[] heap[side];
+    }
+    delete[] touched;
+    delete[] unpackStack;
+}
+
+void ChQuery::push(int side, int key, int vertex) {
+    if (heapSize[side] == heapCapacity[side]) {
+        HeapItem* bigger = new HeapItem[heapCapacity[side] * 2];
+        for (int i = 0; i < heapSize[side]; i++) bigger[i] = heap[side][i];
+        delete[] heap[side];
+        heap[side] = bigger;
+        heapCapacity[side] *= 2;
+    }
+    HeapItem* h = heap[side];
+    int i = heapSize[side]++;
+    while (i > 0 && h[(i - 1) / 2].key > key) {
+        h[i] = h[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    h[i].key = key;
+    h[i].vertex = vertex;
+}
+
+ChQuery::HeapItem ChQuery::pop(int side) {
+    HeapItem* h = heap[side];
+    HeapItem top = h[0];
+    HeapItem last = h[--heapSize[side]];
+    int size = heapSize[side];
+    int i = 0;
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= size) break;
+        if (child + 1 < size && h[child + 1].key < h[child].key) child++;
+        if (h[child].key >= last.key) break;
+        h[i] = h[child];
+        i = child;
+    }
+    if (size > 0) h[i] = last;
+    return top;
+}
+
+void ChQuery::label(int side, int vertex, int d, int from, int mid) {
+    if (dist[0][vertex] == INT_MAX && dist[1][vertex] == INT_MAX) {
+        touched[touchedCount++] = vertex;
+    }
+    dist[side][vertex] = d;
+    parent[side][vertex] = from;
+    middle[side][vertex] = mid;
+}
+
+// writes the original vertices after from up to and including to. A shortcut
+// from-to over mid expands to from-mid and mid-to, and mid ranks below both,
+// so each half is an upward arc of mid. Returns false if a half is missing
+// or the path outgrows the vertex count, which only a bad hierarchy can do.
+bool ChQuery::appendUnpacked(int from, int to, int mid, int* out, int& length) {
+    int n = ch.getNumVertices();
+    int top = 0;
+    auto pushEdge = [&](int a, int b, int m) {
+        if (top + 3 > unpackCapacity) {
+            int* bigger = new int[unpackCapacity * 2];
+            for (int i = 0; i < top; i++) bigger[i] = unpackStack[i];
+            delete[] unpackStack;
+            unpackStack = bigger;
+            unpackCapacity *= 2;
+        }
+        unpackStack[top++] = a;
+        unpackStack[top++] = b;
+        unpackStack[top++] = m;
+    };
+
+    pushEdge(from, to, mid);
+    while (top > 0) {
+        int m = unpackStack[--top];
+        int b = unpackStack[--top];
+        int a = unpackStack[--top];
+        if (m == -1) {
+            if (length == n) return false;
+            out[length++] = b;
+            continue;
+        }
+        const ChArc* second = ch.findUpArc(m, b);
+        const ChArc* first = ch.findUpArc(m, a);
+        if (second == nullptr || first == nullptr) return false;
+        // second half goes on the stack first so the first half comes out first
+        pushEdge(m, b, second->middle);
+        pushEdge(a, m, first->middle);
+    }
+    return true;
+}
+
+PathResult ChQuery::shortestPath(int source, int target) {
+    int n = ch.getNumVertices();
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::invalid_argument("Vertex index out of bounds");
+    }
+
+    // forget the previous query
+    for (int i = 0; i < touchedCount; i++) {
+        dist[0][touched[i]] = INT_MAX;
+        dist[1][touched[i]] = INT_MAX;
+    }
+    touchedCount = 0;
+    heapSize[0] = heapSize[1] = 0;
+
+    PathResult result;
+    label(0, source, 0, -1, -1);
+    label(1, target, 0, -1, -1);
+    push(0, 0, source);
+    push(1, 0, target);
+
+    long long best = INT_MAX;
+    int meeting = -1;
+
+    while (heapSize[0] > 0 || heapSize[1] > 0) {
+        int side;
+        if (heapSize[0] == 0) side = 1;
+        else if (heapSize[1] == 0) side = 0;
+        else side = heap[0][0].key <= heap[1][0].key ? 0 : 1;
+
+        // a side is done once its smallest key cant beat the best meeting
+        if (heap[side][0].key >= best) {
+            heapSize[side] = 0;
+            continue;
+        }
+
+        HeapItem item = pop(side);
+        int u = item.vertex;
+        if (item.key > dist[side][u]) continue;  // stale entry
+        result.settled++;
+
+        int other = 1 - side;
+        if (dist[other][u] != INT_MAX && (long long)item.key + dist[other][u] < best) {
+            best = (long long)item.key + dist[other][u];
+            meeting = u;
+        }
+
+        const ChArc* arcs = ch.getUpArcs(u);
+        int arcCount = ch.getUpArcCount(u);
+        for (int i = 0; i < arcCount; i++) {
+            int v = arcs[i].vertex;
+            int d = item.key + arcs[i].weight;
+            if (d < dist[side][v]) {
+                label(side, v, d, u, arcs[i].middle);
+                push(side, d, v);
+            }
+        }
+    }
+
+    if (meeting == -1) return result;
+
+    // hierarchy path source .. meeting .. target, then unpack every arc
+    result.distance = (int)best;
+    int hops = 1;
+    for (int v = meeting; v != source; v = parent[0][v]) hops++;
+    for (int v = meeting; v != target; v = parent[1][v]) hops++;
+    int* upPath = new int[hops];
+    int* upMiddle = new int[hops];
+    int k = 0;
+    for (int v = meeting; v != source; v = parent[0][v]) k++;
+    int i = k;
+    for (int v = meeting; ; v = parent[0][v]) {
+        upPath[i] = v;
+        upMiddle[i] = middle[0][v];   // arc from upPath[i - 1]
+        if (v == source) break;
+        i--;
+    }
+    i = k;
+    for (int v = meeting; v != target; v = parent[1][v]) {
+        upPath[++i] = parent[1][v];
+        upMiddle[i] = middle[1][v];
+    }
+
+    int* full = new int[n];
+    int length = 0;
+    full[length++] = source;
+    bool unpacked = true;
+    for (int j = 1; j < hops && unpacked; j++) {
+        unpacked = appendUnpacked(upPath[j - 1], upPath[j], upMiddle[j], full, length);
+    }
+    if (!unpacked) {
+        delete[] upPath;
+        delete[] upMiddle;
+        delete[] full;
+        throw std::runtime_error("Shortcut without matching arcs in contraction hierarchy");
+    }
+    result.path = new int[length];
+    for (int j = 0; j < length; j++) result.path[j] = full[j];
+    result.length = length;
+
+    delete[] upPath;
+    delete[] upMiddle;
+    delete[] full;
+    return result;
+}
+
+} // namespace graph
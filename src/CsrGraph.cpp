@@ -0,0 +1,129 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * CsrGraph.cpp - Implementation of the CsrGraph class
+ */
+
+#include "../include/CsrGraph.hpp"
+#include <iostream>
+
+namespace graph {
+
+CsrGraph::CsrGraph(const Graph& g)
+    : numVertices(g.getNumVertices()), numArcs(0), minWeight(g.getMinWeight()), maxWeight(g.getMaxWeight()) {
+    offsets = new int[numVertices + 1];
+
+    // first pass: prefix sums of the list sizes
+    offsets[0] = 0;
+    for (int v = 0; v < numVertices; v++) {
+        offsets[v + 1] = offsets[v] + g.getNeighborCount(v);
+    }
+    numArcs = offsets[numVertices];
+
+    // second pass: copy every list into its slice
+    arcs = new Neighbor[numArcs > 0 ? numArcs : 1];
+    for (int v = 0; v < numVertices; v++) {
+        const Neighbor* neighbors = g.getNeighbors(v);
+        int neighborCount = g.getNeighborCount(v);
+        Neighbor* out = arcs + offsets[v];
+        for (int i = 0; i < neighborCount; i++) {
+            out[i] = neighbors[i];
+        }
+    }
+}
+
+CsrGraph::CsrGraph(int vertices, int* offs, Neighbor* list)
+    : numVertices(vertices), numArcs(offs[vertices]), offsets(offs), arcs(list) {
+    findWeightRange();
+}
+
+void CsrGraph::findWeightRange() {
+    minWeight = 0;
+    maxWeight = 0;
+    for (int i = 0; i < numArcs; i++) {
+        if (i == 0 || arcs[i].weight < minWeight) minWeight = arcs[i].weight;
+        if (i == 0 || arcs[i].weight > maxWeight) maxWeight = arcs[i].weight;
+    }
+}
+
+CsrGraph::~CsrGraph() {
+    delete[] offsets;
+    delete[] arcs;
+}
+
+// Move constructor
+CsrGraph::CsrGraph(CsrGraph&& other) noexcept
+    : numVertices(other.numVertices),
+      numArcs(other.numArcs),
+      offsets(other.offsets),
+      arcs(other.arcs),
+      minWeight(other.minWeight),
+      maxWeight(other.maxWeight) {
+    // Invalidate the other object
+    other.numVertices = 0;
+    other.numArcs = 0;
+    other.offsets = nullptr;
+    other.arcs = nullptr;
+    other.minWeight = 0;
+    other.maxWeight = 0;
+}
+
+// Move assignment operator
+CsrGraph& CsrGraph::operator=(CsrGraph&& other) noexcept {
+    if (this != &other) {
+        // Clean up current resources
+        delete[] offsets;
+        delete[] arcs;
+
+        // Move resources from other
+        numVertices = other.numVertices;
+        numArcs = other.numArcs;
+        offsets = other.offsets;
+        arcs = other.arcs;
+        minWeight = other.minWeight;
+        maxWeight = other.maxWeight;
+
+        // Invalidate the other object
+        other.numVertices = 0;
+        other.numArcs = 0;
+        other.offsets = nullptr;
+        other.arcs = nullptr;
+        other.minWeight = 0;
+        other.maxWeight = 0;
+    }
+    return *this;
+}
+
+CsrGraph CsrGraph::transpose() const {
+    int* offs = new int[numVertices + 1];
+    Neighbor* list = new Neighbor[numArcs > 0 ? numArcs : 1];
+
+    // count incoming arcs, then prefix sums
+    for (int v = 0; v <= numVertices; v++) offs[v] = 0;
+    for (int i = 0; i < numArcs; i++) offs[arcs[i].vertex + 1]++;
+    for (int v = 0; v < numVertices; v++) offs[v + 1] += offs[v];
+
+    // scatter, sources come out in increasing order in every list
+    int* next = new int[numVertices];
+    for (int v = 0; v < numVertices; v++) next[v] = offs[v];
+    for (int u = 0; u < numVertices; u++) {
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            list[next[arcs[i].vertex]++] = Neighbor(u, arcs[i].weight);
+        }
+    }
+    delete[] next;
+
+    return CsrGraph(numVertices, offs, list);
+}
+
+void CsrGraph::print_graph() const {
+    for (int i = 0; i < numVertices; i++) {
+        std::cout << "Vertex " << i << ": ";
+        for (int j = offsets[i]; j < offsets[i + 1]; j++) {
+            std::cout << "(" << arcs[j].vertex
+                     << ", w=" << arcs[j].weight << ") ";
+        }
+        std::cout << std::endl;
+    }
+}
+
+} // namespace graph
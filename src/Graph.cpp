@@ -4,11 +4,13 @@
  */
 
 #include "../include/Graph.hpp"
+#include "../include/CsrGraph.hpp"
 #include <iostream>
 
 namespace graph {
 
-Graph::Graph(int vertices) : numVertices(vertices) {
+Graph::Graph(int vertices)
+    : numVertices(vertices), numArcs(0), minWeight(0), maxWeight(0), weightRangeStale(false) {
     // Initialize adjacency lists
     adjacencyList = new Neighbor*[vertices];
     listSizes = new int[vertices];
@@ -35,12 +37,20 @@ Graph::Graph(Graph&& other) noexcept
     : numVertices(other.numVertices), 
       adjacencyList(other.adjacencyList), 
       listSizes(other.listSizes), 
-      listCapacities(other.listCapacities) {
+      listCapacities(other.listCapacities),
+      numArcs(other.numArcs),
+      minWeight(other.minWeight.load()),
+      maxWeight(other.maxWeight.load()),
+      weightRangeStale(other.weightRangeStale.load()) {
     // Invalidate the other object
     other.numVertices = 0;
     other.adjacencyList = nullptr;
     other.listSizes = nullptr;
     other.listCapacities = nullptr;
+    other.numArcs = 0;
+    other.minWeight = 0;
+    other.maxWeight = 0;
+    other.weightRangeStale = false;
 }
 
 // Move assignment operator
@@ -59,12 +69,20 @@ Graph& Graph::operator=(Graph&& other) noexcept {
         adjacencyList = other.adjacencyList;
         listSizes = other.listSizes;
         listCapacities = other.listCapacities;
+        numArcs = other.numArcs;
+        minWeight = other.minWeight.load();
+        maxWeight = other.maxWeight.load();
+        weightRangeStale = other.weightRangeStale.load();
         
         // Invalidate the other object
         other.numVertices = 0;
         other.adjacencyList = nullptr;
         other.listSizes = nullptr;
         other.listCapacities = nullptr;
+        other.numArcs = 0;
+        other.minWeight = 0;
+        other.maxWeight = 0;
+        other.weightRangeStale = false;
     }
     return *this;
 }
@@ -106,19 +124,56 @@ void Graph::addEdge(int source, int dest, int weight) {
         }
         adjacencyList[v][listSizes[v]] = Neighbor(v == source ? dest : source, weight);
         listSizes[v]++;
+        noteWeight(weight);
     }
 }
 
+// widens the weight range for an arc that was just added, a stale range
+// stays stale and picks the arc up in its rescan
+void Graph::noteWeight(int weight) {
+    if (numArcs == 0) {
+        minWeight = weight;
+        maxWeight = weight;
+        weightRangeStale = false;
+    } else if (!weightRangeStale) {
+        if (weight < minWeight) minWeight = weight;
+        if (weight > maxWeight) maxWeight = weight;
+    }
+    numArcs++;
+}
+
+// full scan, run by the first read after removals touched the range
+void Graph::recomputeWeightRange() const {
+    int low = 0, high = 0;
+    bool first = true;
+    for (int v = 0; v < numVertices; v++) {
+        for (int i = 0; i < listSizes[v]; i++) {
+            int weight = adjacencyList[v][i].weight;
+            if (first || weight < low) low = weight;
+            if (first || weight > high) high = weight;
+            first = false;
+        }
+    }
+    minWeight.store(low, std::memory_order_relaxed);
+    maxWeight.store(high, std::memory_order_relaxed);
+    weightRangeStale.store(false, std::memory_order_release);
+}
+
 void Graph::removeFromList(int vertex, int neighbor) {
     int i = 0;
     while (i < listSizes[vertex] && adjacencyList[vertex][i].vertex != neighbor) {
         i++;
     }
     if (i < listSizes[vertex]) {
+        int weight = adjacencyList[vertex][i].weight;
         for (int j = i; j < listSizes[vertex] - 1; j++) {
             adjacencyList[vertex][j] = adjacencyList[vertex][j + 1];
         }
         listSizes[vertex]--;
+        numArcs--;
+        if (weight == minWeight || weight == maxWeight) {
+            weightRangeStale = true;
+        }
     }
 }
 
@@ -162,6 +217,11 @@ void Graph::addDirectedEdge(int source, int dest, int weight) {
     }
     adjacencyList[source][listSizes[source]] = Neighbor(dest, weight);
     listSizes[source]++;
+    noteWeight(weight);
+}
+
+CsrGraph Graph::freeze() const {
+    return CsrGraph(*this);
 }
 
-} // namespace graph 
\ No newline at end of file
+} // namespace graph
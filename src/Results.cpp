@@ -0,0 +1,783 @@
+/*
+ * Email: abedallahamodi803@gmail.com
+ * Results.cpp - Implementation of the algorithm result types
+ */
+
+#include "../include/Results.hpp"
+#include <climits>  // For INT_MAX
+#include <utility>
+
+namespace graph {
+
+// TraversalResult implementation
+TraversalResult::TraversalResult(int vertices) : numVertices(vertices), orderSize(0) {
+    order = new int[vertices];
+    parent = new int[vertices];
+    depth = new int[vertices];
+    parentWeight = new int[vertices];
+    for (int i = 0; i < vertices; i++) {
+        parent[i] = -1;
+        depth[i] = -1;
+        parentWeight[i] = 0;
+    }
+}
+
+TraversalResult::~TraversalResult() {
+    delete[] order;
+    delete[] parent;
+    delete[] depth;
+    delete[] parentWeight;
+}
+
+TraversalResult::TraversalResult(TraversalResult&& other) noexcept
+    : numVertices(other.numVertices),
+      order(other.order),
+      orderSize(other.orderSize),
+      parent(other.parent),
+      depth(other.depth),
+      parentWeight(other.parentWeight) {
+    other.numVertices = 0;
+    other.order = nullptr;
+    other.orderSize = 0;
+    other.parent = nullptr;
+    other.depth = nullptr;
+    other.parentWeight = nullptr;
+}
+
+TraversalResult& TraversalResult::operator=(TraversalResult&& other) noexcept {
+    if (this != &other) {
+        delete[] order;
+        delete[] parent;
+        delete[] depth;
+        delete[] parentWeight;
+
+        numVertices = other.numVertices;
+        order = other.order;
+        orderSize = other.orderSize;
+        parent = other.parent;
+        depth = other.depth;
+        parentWeight = other.parentWeight;
+
+        other.numVertices = 0;
+        other.order = nullptr;
+        other.orderSize = 0;
+        other.parent = nullptr;
+        other.depth = nullptr;
+        other.parentWeight = nullptr;
+    }
+    return *this;
+}
+
+Graph TraversalResult::toGraph() const {
+    Graph result(numVertices);
+    // visit order puts every parent before its children
+    for (int i = 0; i < orderSize; i++) {
+        int v = order[i];
+        if (parent[v] != -1) {
+            result.addDirectedEdge(parent[v], v, parentWeight[v]);
+        }
+    }
+    return result;
+}
+
+// DfsResult implementation
+DfsResult::DfsResult(int vertices) : TraversalResult(vertices) {
+    discovery = new int[vertices];
+    finish = new int[vertices];
+    postOrder = new int[vertices];
+    for (int i = 0; i < vertices; i++) {
+        discovery[i] = -1;
+        finish[i] = -1;
+    }
+}
+
+DfsResult::~DfsResult() {
+    delete[] discovery;
+    delete[] finish;
+    delete[] postOrder;
+}
+
+DfsResult::DfsResult(DfsResult&& other) noexcept
+    : TraversalResult(std::move(other)),
+      discovery(other.discovery),
+      finish(other.finish),
+      postOrder(other.postOrder) {
+    other.discovery = nullptr;
+    other.finish = nullptr;
+    other.postOrder = nullptr;
+}
+
+DfsResult& DfsResult::operator=(DfsResult&& other) noexcept {
+    if (this != &other) {
+        TraversalResult::operator=(std::move(other));
+        delete[] discovery;
+        delete[] finish;
+        delete[] postOrder;
+
+        discovery = other.discovery;
+        finish = other.finish;
+        postOrder = other.postOrder;
+
+        other.discovery = nullptr;
+        other.finish = nullptr;
+        other.postOrder = nullptr;
+    }
+    return *this;
+}
+
+// MultiSourceDistances implementation
+MultiSourceDistances::MultiSourceDistances(int sources, int vertices)
+    : numSources(sources), numVertices(vertices) {
+    long long cells = (long long)sources * vertices;
+    dist = new int[cells > 0 ? cells : 1];
+    for (long long i = 0; i < cells; i++) {
+        dist[i] = -1;
+    }
+}
+
+MultiSourceDistances::~MultiSourceDistances() {
+    delete[] dist;
+}
+
+MultiSourceDistances::MultiSourceDistances(MultiSourceDistances&& other) noexcept
+    : numSources(other.numSources),
+      numVertices(other.numVertices),
+      dist(other.dist) {
+    other.numSources = 0;
+    other.numVertices = 0;
+    other.dist = nullptr;
+}
+
+MultiSourceDistances& MultiSourceDistances::operator=(MultiSourceDistances&& other) noexcept {
+    if (this != &other) {
+        delete[] dist;
+
+        numSources = other.numSources;
+        numVertices = other.numVertices;
+        dist = other.dist;
+
+        other.numSources = 0;
+        other.numVertices = 0;
+        other.dist = nullptr;
+    }
+    return *this;
+}
+
+// ShortestPathResult implementation
+ShortestPathResult::ShortestPathResult(int vertices, int src) : numVertices(vertices), source(src) {
+    dist = new int[vertices];
+    parent = new int[vertices];
+    for (int i = 0; i < vertices; i++) {
+        dist[i] = INT_MAX;
+        parent[i] = -1;
+    }
+}
+
+ShortestPathResult::~ShortestPathResult() {
+    delete[] dist;
+    delete[] parent;
+}
+
+ShortestPathResult::ShortestPathResult(ShortestPathResult&& other) noexcept
+    : numVertices(other.numVertices),
+      source(other.source),
+      dist(other.dist),
+      parent(other.parent) {
+    other.numVertices = 0;
+    other.dist = nullptr;
+    other.parent = nullptr;
+}
+
+ShortestPathResult& ShortestPathResult::operator=(ShortestPathResult&& other) noexcept {
+    if (this != &other) {
+        delete[] dist;
+        delete[] parent;
+
+        numVertices = other.numVertices;
+        source = other.source;
+        dist = other.dist;
+        parent = other.parent;
+
+        other.numVertices = 0;
+        other.dist = nullptr;
+        other.parent = nullptr;
+    }
+    return *this;
+}
+
+bool ShortestPathResult::reached(int vertex) const {
+    return dist[vertex] != INT_MAX;
+}
+
+int ShortestPathResult::pathLength(int target) const {
+    if (!reached(target)) return 0;
+    int length = 1;
+    for (int v = target; v != source; v = parent[v]) {
+        length++;
+    }
+    return length;
+}
+
+int ShortestPathResult::pathTo(int target, int* out) const {
+    int length = pathLength(target);
+    int i = length - 1;
+    for (int v = target; i >= 0; v = parent[v]) {
+        out[i--] = v;
+    }
+    return length;
+}
+
+Graph ShortestPathResult::toGraph() const {
+    Graph result(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        if (parent[v] != -1) {
+            result.addDirectedEdge(parent[v], v, dist[v] - dist[parent[v]]);
+        }
+    }
+    return result;
+}
+
+// PathResult implementation
+PathResult::PathResult() : distance(INT_MAX), path(nullptr), length(0), settled(0) {}
+
+PathResult::~PathResult() {
+    delete[] path;
+}
+
+PathResult::PathResult(PathResult&& other) noexcept
+    : distance(other.distance),
+      path(other.path),
+      length(other.length),
+      settled(other.settled) {
+    other.distance = INT_MAX;
+    other.path = nullptr;
+    other.length = 0;
+    other.settled = 0;
+}
+
+PathResult& PathResult::operator=(PathResult&& other) noexcept {
+    if (this != &other) {
+        delete[] path;
+
+        distance = other.distance;
+        path = other.path;
+        length = other.length;
+        settled = other.settled;
+
+        other.distance = INT_MAX;
+        other.path = nullptr;
+        other.length = 0;
+        other.settled = 0;
+    }
+    return *this;
+}
+
+// LandmarkIndex implementation
+LandmarkIndex::LandmarkIndex(int vertices, int count) : numVertices(vertices), numLandmarks(count) {
+    landmarks = new int[count > 0 ? count : 1];
+    dist = new int[(long long)count * vertices > 0 ? (long long)count * vertices : 1];
+}
+
+LandmarkIndex::~LandmarkIndex() {
+    delete[] landmarks;
+    delete[] dist;
+}
+
+LandmarkIndex::LandmarkIndex(LandmarkIndex&& other) noexcept
+    : numVertices(other.numVertices),
+      numLandmarks(other.numLandmarks),
+      landmarks(other.landmarks),
+      dist(other.dist) {
+    other.numVertices = 0;
+    other.numLandmarks = 0;
+    other.landmarks = nullptr;
+    other.dist = nullptr;
+}
+
+LandmarkIndex& LandmarkIndex::operator=(LandmarkIndex&& other) noexcept {
+    if (this != &other) {
+        delete[] landmarks;
+        delete[] dist;
+
+        numVertices = other.numVertices;
+        numLandmarks = other.numLandmarks;
+        landmarks = other.landmarks;
+        dist = other.dist;
+
+        other.numVertices = 0;
+        other.numLandmarks = 0;
+        other.landmarks = nullptr;
+        other.dist = nullptr;
+    }
+    return *this;
+}
+
+int LandmarkIndex::lowerBound(int v, int target) const {
+    int best = 0;
+    for (int l = 0; l < numLandmarks; l++) {
+        const int* row = dist + (long long)l * numVertices;
+        if (row[v] == INT_MAX || row[target] == INT_MAX) continue;
+        int bound = row[v] > row[target] ? row[v] - row[target] : row[target] - row[v];
+        if (bound > best) best = bound;
+    }
+    return best;
+}
+
+// SpanningForest implementation
+SpanningForest::SpanningForest(int vertices) : numVertices(vertices), edgeCount(0), totalWeight(0) {
+    edges = new Edge[vertices > 1 ? vertices - 1 : 1];
+}
+
+SpanningForest::~SpanningForest() {
+    delete[] edges;
+}
+
+SpanningForest::SpanningForest(SpanningForest&& other) noexcept
+    : numVertices(other.numVertices),
+      edges(other.edges),
+      edgeCount(other.edgeCount),
+      totalWeight(other.totalWeight) {
+    other.numVertices = 0;
+    other.edges = nullptr;
+    other.edgeCount = 0;
+    other.totalWeight = 0;
+}
+
+SpanningForest& SpanningForest::operator=(SpanningForest&& other) noexcept {
+    if (this != &other) {
+        delete[] edges;
+
+        numVertices = other.numVertices;
+        edges = other.edges;
+        edgeCount = other.edgeCount;
+        totalWeight = other.totalWeight;
+
+        other.numVertices = 0;
+        other.edges = nullptr;
+        other.edgeCount = 0;
+        other.totalWeight = 0;
+    }
+    return *this;
+}
+
+void SpanningForest::add(int u, int v, int weight) {
+    edges[edgeCount].u = u;
+    edges[edgeCount].v = v;
+    edges[edgeCount].weight = weight;
+    edgeCount++;
+    totalWeight += weight;
+}
+
+Graph SpanningForest::toGraph() const {
+    Graph result(numVertices);
+    for (int i = 0; i < edgeCount; i++) {
+        result.addEdge(edges[i].u, edges[i].v, edges[i].weight);
+    }
+    return result;
+}
+
+// ComponentLabels implementation
+ComponentLabels::ComponentLabels(int vertices) : numVertices(vertices), numComponents(0) {
+    component = new int[vertices > 0 ? vertices : 1];
+    for (int i = 0; i < vertices; i++) {
+        component[i] = -1;
+    }
+}
+
+ComponentLabels::~ComponentLabels() {
+    delete[] component;
+}
+
+ComponentLabels::ComponentLabels(ComponentLabels&& other) noexcept
+    : numVertices(other.numVertices),
+      component(other.component),
+      numComponents(other.numComponents) {
+    other.numVertices = 0;
+    other.component = nullptr;
+    other.numComponents = 0;
+}
+
+ComponentLabels& ComponentLabels::operator=(ComponentLabels&& other) noexcept {
+    if (this != &other) {
+        delete[] component;
+
+        numVertices = other.numVertices;
+        component = other.component;
+        numComponents = other.numComponents;
+
+        other.numVertices = 0;
+        other.component = nullptr;
+        other.numComponents = 0;
+    }
+    return *this;
+}
+
+// SccResult implementation
+SccResult::SccResult(int vertices)
+    : ComponentLabels(vertices), condensation(0, new int[1](), new Neighbor[1]) {}
+
+SccResult::SccResult(SccResult&& other) noexcept
+    : ComponentLabels(std::move(other)),
+      condensation(std::move(other.condensation)) {}
+
+SccResult& SccResult::operator=(SccResult&& other) noexcept {
+    if (this != &other) {
+        ComponentLabels::operator=(std::move(other));
+        condensation = std::move(other.condensation);
+    }
+    return *this;
+}
+
+// BiconnectivityResult implementation
+BiconnectivityResult::BiconnectivityResult(int vertices, int arcs)
+    : numVertices(vertices), numArcs(arcs), numComponents(0), bridgeCount(0) {
+    articulation = new bool[vertices > 0 ? vertices : 1];
+    arcComponent = new int[arcs > 0 ? arcs : 1];
+    bridges = new Edge[vertices > 0 ? vertices : 1];
+    for (int i = 0; i < vertices; i++) {
+        articulation[i] = false;
+    }
+    for (int i = 0; i < arcs; i++) {
+        arcComponent[i] = -1;
+    }
+}
+
+BiconnectivityResult::~BiconnectivityResult() {
+    delete[] articulation;
+    delete[] arcComponent;
+    delete[] bridges;
+}
+
+BiconnectivityResult::BiconnectivityResult(BiconnectivityResult&& other) noexcept
+    : numVertices(other.numVertices),
+      numArcs(other.numArcs),
+      articulation(other.articulation),
+      arcComponent(other.arcComponent),
+      numComponents(other.numComponents),
+      bridges(other.bridges),
+      bridgeCount(other.bridgeCount) {
+    other.numVertices = 0;
+    other.numArcs = 0;
+    other.articulation = nullptr;
+    other.arcComponent = nullptr;
+    other.numComponents = 0;
+    other.bridges = nullptr;
+    other.bridgeCount = 0;
+}
+
+BiconnectivityResult& BiconnectivityResult::operator=(BiconnectivityResult&& other) noexcept {
+    if (this != &other) {
+        delete[] articulation;
+        delete[] arcComponent;
+        delete[] bridges;
+
+        numVertices = other.numVertices;
+        numArcs = other.numArcs;
+        articulation = other.articulation;
+        arcComponent = other.arcComponent;
+        numComponents = other.numComponents;
+        bridges = other.bridges;
+        bridgeCount = other.bridgeCount;
+
+        other.numVertices = 0;
+        other.numArcs = 0;
+        other.articulation = nullptr;
+        other.arcComponent = nullptr;
+        other.numComponents = 0;
+        other.bridges = nullptr;
+        other.bridgeCount = 0;
+    }
+    return *this;
+}
+
+// PageRankResult implementation
+PageRankResult::PageRankResult(int vertices, int maxIterations)
+    : numVertices(vertices), iterations(0), residual(0), converged(false) {
+    rank = new double[vertices > 0 ? vertices : 1];
+    iterationSeconds = new double[maxIterations > 0 ? maxIterations : 1];
+    for (int i = 0; i < vertices; i++) {
+        rank[i] = 1.0 / vertices;
+    }
+}
+
+PageRankResult::~PageRankResult() {
+    delete[] rank;
+    delete[] iterationSeconds;
+}
+
+PageRankResult::PageRankResult(PageRankResult&& other) noexcept
+    : numVertices(other.numVertices),
+      rank(other.rank),
+      iterations(other.iterations),
+      residual(other.residual),
+      converged(other.converged),
+      iterationSeconds(other.iterationSeconds) {
+    other.numVertices = 0;
+    other.rank = nullptr;
+    other.iterations = 0;
+    other.iterationSeconds = nullptr;
+}
+
+PageRankResult& PageRankResult::operator=(PageRankResult&& other) noexcept {
+    if (this != &other) {
+        delete[] rank;
+        delete[] iterationSeconds;
+
+        numVertices = other.numVertices;
+        rank = other.rank;
+        iterations = other.iterations;
+        residual = other.residual;
+        converged = other.converged;
+        iterationSeconds = other.iterationSeconds;
+
+        other.numVertices = 0;
+        other.rank = nullptr;
+        other.iterations = 0;
+        other.iterationSeconds = nullptr;
+    }
+    return *this;
+}
+
+// BetweennessResult implementation
+BetweennessResult::BetweennessResult(int vertices)
+    : numVertices(vertices), sourcesUsed(0), errorBound(0) {
+    score = new double[vertices > 0 ? vertices : 1];
+    for (int i = 0; i < vertices; i++) {
+        score[i] = 0;
+    }
+}
+
+BetweennessResult::~BetweennessResult() {
+    delete[] score;
+}
+
+BetweennessResult::BetweennessResult(BetweennessResult&& other) noexcept
+    : numVertices(other.numVertices),
+      score(other.score),
+      sourcesUsed(other.sourcesUsed),
+      errorBound(other.errorBound) {
+    other.numVertices = 0;
+    other.score = nullptr;
+    other.sourcesUsed = 0;
+    other.errorBound = 0;
+}
+
+BetweennessResult& BetweennessResult::operator=(BetweennessResult&& other) noexcept {
+    if (this != &other) {
+        delete[] score;
+
+        numVertices = other.numVertices;
+        score = other.score;
+        sourcesUsed = other.sourcesUsed;
+        errorBound = other.errorBound;
+
+        other.numVertices = 0;
+        other.score = nullptr;
+        other.sourcesUsed = 0;
+        other.errorBound = 0;
+    }
+    return *this;
+}
+
+// TriangleResult implementation
+TriangleResult::TriangleResult(int vertices) : numVertices(vertices), total(0) {
+    perVertex = new long long[vertices > 0 ? vertices : 1];
+    clustering = new double[vertices > 0 ? vertices : 1];
+    for (int i = 0; i < vertices; i++) {
+        perVertex[i] = 0;
+        clustering[i] = 0;
+    }
+}
+
+TriangleResult::~TriangleResult() {
+    delete[] perVertex;
+    delete[] clustering;
+}
+
+TriangleResult::TriangleResult(TriangleResult&& other) noexcept
+    : numVertices(other.numVertices),
+      total(other.total),
+      perVertex(other.perVertex),
+      clustering(other.clustering) {
+    other.numVertices = 0;
+    other.total = 0;
+    other.perVertex = nullptr;
+    other.clustering = nullptr;
+}
+
+TriangleResult& TriangleResult::operator=(TriangleResult&& other) noexcept {
+    if (this != &other) {
+        delete[] perVertex;
+        delete[] clustering;
+
+        numVertices = other.numVertices;
+        total = other.total;
+        perVertex = other.perVertex;
+        clustering = other.clustering;
+
+        other.numVertices = 0;
+        other.total = 0;
+        other.perVertex = nullptr;
+        other.clustering = nullptr;
+    }
+    return *this;
+}
+
+// CoreResult implementation
+CoreResult::CoreResult(int vertices) : numVertices(vertices), maxCore(0) {
+    core = new int[vertices > 0 ? vertices : 1];
+    for (int i = 0; i < vertices; i++) {
+        core[i] = 0;
+    }
+}
+
+CoreResult::~CoreResult() {
+    delete[] core;
+}
+
+CoreResult::CoreResult(CoreResult&& other) noexcept
+    : numVertices(other.numVertices),
+      core(other.core),
+      maxCore(other.maxCore) {
+    other.numVertices = 0;
+    other.core = nullptr;
+    other.maxCore = 0;
+}
+
+CoreResult& CoreResult::operator=(CoreResult&& other) noexcept {
+    if (this != &other) {
+        delete[] core;
+
+        numVertices = other.numVertices;
+        core = other.core;
+        maxCore = other.maxCore;
+
+        other.numVertices = 0;
+        other.core = nullptr;
+        other.maxCore = 0;
+    }
+    return *this;
+}
+
+// CommunityResult implementation
+CommunityResult::CommunityResult(int vertices)
+    : numVertices(vertices), numCommunities(vertices), modularity(0), levels(0) {
+    community = new int[vertices > 0 ? vertices : 1];
+    for (int i = 0; i < vertices; i++) {
+        community[i] = i;
+    }
+}
+
+CommunityResult::~CommunityResult() {
+    delete[] community;
+}
+
+CommunityResult::CommunityResult(CommunityResult&& other) noexcept
+    : numVertices(other.numVertices),
+      community(other.community),
+      numCommunities(other.numCommunities),
+      modularity(other.modularity),
+      levels(other.levels) {
+    other.numVertices = 0;
+    other.community = nullptr;
+    other.numCommunities = 0;
+    other.modularity = 0;
+    other.levels = 0;
+}
+
+CommunityResult& CommunityResult::operator=(CommunityResult&& other) noexcept {
+    if (this != &other) {
+        delete[] community;
+
+        numVertices = other.numVertices;
+        community = other.community;
+        numCommunities = other.numCommunities;
+        modularity = other.modularity;
+        levels = other.levels;
+
+        other.numVertices = 0;
+        other.community = nullptr;
+        other.numCommunities = 0;
+        other.modularity = 0;
+        other.levels = 0;
+    }
+    return *this;
+}
+
+// PprWorkspace implementation
+PprWorkspace::PprWorkspace(int vertices) : numVertices(vertices), touchedCount(0) {
+    estimate = new double[vertices > 0 ? vertices : 1];
+    residual = new double[vertices > 0 ? vertices : 1];
+    touched = new int[vertices > 0 ? vertices : 1];
+    queue = new int[vertices > 0 ? vertices : 1];
+    queued = new bool[vertices > 0 ? vertices : 1];
+    for (int i = 0; i < vertices; i++) {
+        estimate[i] = 0;
+        residual[i] = 0;
+        queued[i] = false;
+    }
+}
+
+PprWorkspace::~PprWorkspace() {
+    delete[] estimate;
+    delete[] residual;
+    delete[] touched;
+    delete[] queue;
+    delete[] queued;
+}
+
+PprWorkspace::PprWorkspace(PprWorkspace&& other) noexcept
+    : numVertices(other.numVertices),
+      estimate(other.estimate),
+      residual(other.residual),
+      touched(other.touched),
+      touchedCount(other.touchedCount),
+      queue(other.queue),
+      queued(other.queued) {
+    other.numVertices = 0;
+    other.estimate = nullptr;
+    other.residual = nullptr;
+    other.touched = nullptr;
+    other.touchedCount = 0;
+    other.queue = nullptr;
+    other.queued = nullptr;
+}
+
+PprWorkspace& PprWorkspace::operator=(PprWorkspace&& other) noexcept {
+    if (this != &other) {
+        delete[] estimate;
+        delete[] residual;
+        delete[] touched;
+        delete[] queue;
+        delete[] queued;
+
+        numVertices = other.numVertices;
+        estimate = other.estimate;
+        residual = other.residual;
+        touched = other.touched;
+        touchedCount = other.touchedCount;
+        queue = other.queue;
+        queued = other.queued;
+
+        other.numVertices = 0;
+        other.estimate = nullptr;
+        other.residual = nullptr;
+        other.touched = nullptr;
+        other.touchedCount = 0;
+        other.queue = nullptr;
+        other.queued = nullptr;
+    }
+    return *this;
+}
+
+void PprWorkspace::clear() {
+    for (int i = 0; i < touchedCount; i++) {
+        int v = touched[i];
+        estimate[v] = 0;
+        residual[v] = 0;
+        queued[v] = false;
+    }
+    touchedCount = 0;
+}
+
+} // namespace graph
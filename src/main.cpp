@@ -33,35 +33,35 @@ int main() {
     
     // Demonstrate BFS
     std::cout << "BFS Tree starting from vertex 0:" << std::endl;
-    Graph bfsTree = Algorithms::bfs(g, 0);
+    Graph bfsTree = Algorithms::bfs(g, 0).toGraph();
     bfsTree.print_graph();
     
     printSeparator();
     
     // Demonstrate DFS
     std::cout << "DFS Tree starting from vertex 0:" << std::endl;
-    Graph dfsTree = Algorithms::dfs(g, 0);
+    Graph dfsTree = Algorithms::dfs(g, 0).toGraph();
     dfsTree.print_graph();
     
     printSeparator();
     
     // Demonstrate Dijkstra's algorithm
     std::cout << "Shortest Paths Tree from vertex 0:" << std::endl;
-    Graph dijkstraTree = Algorithms::dijkstra(g, 0);
+    Graph dijkstraTree = Algorithms::dijkstra(g, 0).toGraph();
     dijkstraTree.print_graph();
     
     printSeparator();
     
     // Demonstrate Prim's algorithm
     std::cout << "Minimum Spanning Tree (Prim's):" << std::endl;
-    Graph primTree = Algorithms::prim(g);
+    Graph primTree = Algorithms::prim(g).toGraph();
     primTree.print_graph();
     
     printSeparator();
     
     // Demonstrate Kruskal's algorithm
     std::cout << "Minimum Spanning Tree (Kruskal's):" << std::endl;
-    Graph kruskalTree = Algorithms::kruskal(g);
+    Graph kruskalTree = Algorithms::kruskal(g).toGraph();
     kruskalTree.print_graph();
     
     return 0;
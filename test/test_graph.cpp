@@ -7,9 +7,63 @@
 #include "./doctest.h"
 #include "../include/Graph.hpp"
 #include "../include/Algorithms.hpp"
+#include "../include/Simd.hpp"
+#include <cstdio>
 
 using namespace graph;
 
+// deterministic pseudo random graph, skewed so low ids get most edges
+static void addRandomEdges(Graph& g, int edges, unsigned seed, bool directed = false, int maxWeight = 1) {
+    int n = g.getNumVertices();
+    unsigned state = seed;
+    auto next = [&state]() {
+        state = state * 1103515245u + 12345u;
+        return (state >> 8) & 0xFFFFFF;
+    };
+    for (int added = 0; added < edges;) {
+        int u = (int)(next() % n);
+        int v = (int)(next() % (u + 1 + next() % n) % n);
+        int w = 1 + (int)(next() % maxWeight);
+        try {
+            if (directed) g.addDirectedEdge(u, v, w);
+            else g.addEdge(u, v, w);
+            added++;
+        } catch (const std::invalid_argument&) {
+            // self loop or duplicate, draw again
+        }
+    }
+}
+
+// true if dist[v] == dist[parent[v]] + w(parent[v], v) for every reached v
+static bool isShortestPathTree(const Graph& g, const ShortestPathResult& r) {
+    for (int v = 0; v < g.getNumVertices(); v++) {
+        if (v == r.source || !r.reached(v)) continue;
+        int p = r.parent[v];
+        if (p < 0) return false;
+        bool found = false;
+        for (int i = 0; i < g.getNeighborCount(p); i++) {
+            const Neighbor& e = g.getNeighbors(p)[i];
+            if (e.vertex == v && r.dist[p] + e.weight == r.dist[v]) found = true;
+        }
+        if (!found) return false;
+    }
+    return true;
+}
+
+// true if path is a walk in g whose weights add up to distance
+static bool isPathOfLength(const Graph& g, const PathResult& r) {
+    long long total = 0;
+    for (int i = 0; i + 1 < r.length; i++) {
+        int w = -1;
+        for (int j = 0; j < g.getNeighborCount(r.path[i]); j++) {
+            if (g.getNeighbors(r.path[i])[j].vertex == r.path[i + 1]) w = g.getNeighbors(r.path[i])[j].weight;
+        }
+        if (w < 0) return false;
+        total += w;
+    }
+    return total == r.distance;
+}
+
 // testing basic stuff
 TEST_CASE("Graph Basic Operations") {
     Graph g(5);
@@ -54,25 +108,25 @@ TEST_CASE("Graph Algorithms") {
     g.addEdge(4, 5, 6);
     
     SUBCASE("BFS") {
-        Graph bfsTree = Algorithms::bfs(g, 0);
+        Graph bfsTree = Algorithms::bfs(g, 0).toGraph();
         CHECK(bfsTree.getNeighborCount(0) > 0);
         CHECK(bfsTree.getNeighborCount(5) == 0);
     }
     
     SUBCASE("DFS") {
-        Graph dfsTree = Algorithms::dfs(g, 0);
+        Graph dfsTree = Algorithms::dfs(g, 0).toGraph();
         CHECK(dfsTree.getNeighborCount(0) > 0);
         CHECK(dfsTree.getNeighborCount(5) == 0);
     }
     
     SUBCASE("Dijkstra") {
-        Graph dijkstraTree = Algorithms::dijkstra(g, 0);
+        Graph dijkstraTree = Algorithms::dijkstra(g, 0).toGraph();
         CHECK(dijkstraTree.getNeighborCount(0) > 0);
         CHECK(dijkstraTree.getNeighborCount(5) == 0);
     }
     
     SUBCASE("Prim") {
-        Graph primTree = Algorithms::prim(g);
+        Graph primTree = Algorithms::prim(g).toGraph();
         int totalEdges = 0;
         for (int i = 0; i < primTree.getNumVertices(); i++) {
             totalEdges += primTree.getNeighborCount(i);
@@ -81,11 +135,1237 @@ TEST_CASE("Graph Algorithms") {
     }
     
     SUBCASE("Kruskal") {
-        Graph kruskalTree = Algorithms::kruskal(g);
+        Graph kruskalTree = Algorithms::kruskal(g).toGraph();
         int totalEdges = 0;
         for (int i = 0; i < kruskalTree.getNumVertices(); i++) {
             totalEdges += kruskalTree.getNeighborCount(i);
         }
         CHECK(totalEdges == 2 * (kruskalTree.getNumVertices() - 1));
     }
-} 
\ No newline at end of file
+}
+
+// frozen snapshot should look exactly like the graph it came from
+TEST_CASE("CSR Snapshot") {
+    Graph g(6);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 3);
+    g.addEdge(1, 2, 1);
+    g.addEdge(1, 3, 2);
+    g.addEdge(2, 3, 4);
+    g.addEdge(3, 4, 2);
+    g.addEdge(4, 5, 6);
+
+    CsrGraph csr = g.freeze();
+    CHECK(csr.getNumVertices() == 6);
+    CHECK(csr.getNumArcs() == 14);
+    for (int v = 0; v < 6; v++) {
+        REQUIRE(csr.getNeighborCount(v) == g.getNeighborCount(v));
+        for (int i = 0; i < g.getNeighborCount(v); i++) {
+            CHECK(csr.getNeighbors(v)[i].vertex == g.getNeighbors(v)[i].vertex);
+            CHECK(csr.getNeighbors(v)[i].weight == g.getNeighbors(v)[i].weight);
+        }
+    }
+
+    SUBCASE("Algorithms accept the snapshot") {
+        Graph bfsTree = Algorithms::bfs(csr, 0).toGraph();
+        CHECK(bfsTree.getNeighborCount(5) == 0);
+        Graph primTree = Algorithms::prim(csr).toGraph();
+        Graph kruskalTree = Algorithms::kruskal(csr).toGraph();
+        int primEdges = 0, kruskalEdges = 0;
+        for (int i = 0; i < 6; i++) {
+            primEdges += primTree.getNeighborCount(i);
+            kruskalEdges += kruskalTree.getNeighborCount(i);
+        }
+        CHECK(primEdges == 10);
+        CHECK(kruskalEdges == 10);
+    }
+}
+
+// dense graphs used to overflow the fixed size heap
+TEST_CASE("Indexed Heap On Dense Graphs") {
+    const int n = 40;
+    Graph g(n);
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            g.addEdge(i, j, 1000 - i * 20 - j);
+        }
+    }
+
+    // weights fit Dial's range, so dijkstra() takes the buckets; the heap
+    // has to be asked for by name
+    ShortestPathResult buckets = Algorithms::dijkstra(g, 0);
+    ShortestPathResult heap = Algorithms::dijkstraHeap(g, 0);
+    for (int v = 0; v < n; v++) {
+        REQUIRE(heap.dist[v] == buckets.dist[v]);
+    }
+    CHECK(isShortestPathTree(g, heap));
+
+    Graph primTree = Algorithms::prim(g).toGraph();
+    Graph kruskalTree = Algorithms::kruskal(g).toGraph();
+    long long primWeight = 0, kruskalWeight = 0;
+    for (int v = 0; v < n; v++) {
+        for (int i = 0; i < primTree.getNeighborCount(v); i++) {
+            primWeight += primTree.getNeighbors(v)[i].weight;
+        }
+        for (int i = 0; i < kruskalTree.getNeighborCount(v); i++) {
+            kruskalWeight += kruskalTree.getNeighbors(v)[i].weight;
+        }
+    }
+    CHECK(primWeight == kruskalWeight);
+}
+
+// big enough for the radix sort to split into chunks, with negative weights
+TEST_CASE("Kruskal Edge Pipeline") {
+    const int n = 400;
+    Graph g(n);
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            g.addEdge(i, j, (i * 7919 + j * 104729) % 2001 - 1000);
+        }
+    }
+
+    Graph primTree = Algorithms::prim(g).toGraph();
+    Graph kruskalTree = Algorithms::kruskal(g).toGraph();
+    long long primWeight = 0, kruskalWeight = 0;
+    int kruskalEdges = 0;
+    for (int v = 0; v < n; v++) {
+        for (int i = 0; i < primTree.getNeighborCount(v); i++) {
+            primWeight += primTree.getNeighbors(v)[i].weight;
+        }
+        for (int i = 0; i < kruskalTree.getNeighborCount(v); i++) {
+            kruskalWeight += kruskalTree.getNeighbors(v)[i].weight;
+        }
+        kruskalEdges += kruskalTree.getNeighborCount(v);
+    }
+    CHECK(kruskalEdges == 2 * (n - 1));
+    CHECK(primWeight == kruskalWeight);
+}
+
+// flat result arrays instead of result graphs
+TEST_CASE("Result Types") {
+    Graph g(7);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 3);
+    g.addEdge(1, 2, 1);
+    g.addEdge(1, 3, 2);
+    g.addEdge(2, 3, 4);
+    g.addEdge(3, 4, 2);
+    g.addEdge(4, 5, 6);
+
+    SUBCASE("BFS depths and parents") {
+        TraversalResult r = Algorithms::bfs(g, 0);
+        CHECK(r.orderSize == 6);
+        CHECK(r.order[0] == 0);
+        CHECK(r.depth[3] == 2);
+        CHECK(r.depth[5] == 4);
+        CHECK(r.parent[5] == 4);
+        CHECK_FALSE(r.reached(6));
+    }
+
+    SUBCASE("Dijkstra distances and path") {
+        ShortestPathResult r = Algorithms::dijkstra(g, 0);
+        CHECK(r.dist[1] == 4);
+        CHECK(r.dist[3] == 6);
+        CHECK(r.dist[5] == 14);
+        CHECK_FALSE(r.reached(6));
+        CHECK(r.pathLength(6) == 0);
+
+        int path[7];
+        int length = r.pathTo(5, path);
+        REQUIRE(length == 5);
+        CHECK(path[0] == 0);
+        CHECK(path[2] == 3);
+        CHECK(path[4] == 5);
+
+        // the tree has exactly one incoming edge per reached vertex
+        Graph tree = r.toGraph();
+        int treeEdges = 0;
+        for (int v = 0; v < 7; v++) treeEdges += tree.getNeighborCount(v);
+        CHECK(treeEdges == 5);
+    }
+
+    SUBCASE("Spanning forest of a disconnected graph") {
+        Graph h(5);
+        h.addEdge(0, 1, 2);
+        h.addEdge(1, 2, 1);
+        h.addEdge(0, 2, 5);
+        h.addEdge(3, 4, 7);
+        SpanningForest prim = Algorithms::prim(h);
+        SpanningForest kruskal = Algorithms::kruskal(h);
+        CHECK(prim.edgeCount == 3);
+        CHECK(kruskal.edgeCount == 3);
+        CHECK(prim.totalWeight == 10);
+        CHECK(kruskal.totalWeight == 10);
+    }
+
+    CHECK_THROWS_AS(Algorithms::bfs(g, 7), std::invalid_argument);
+}
+
+// same levels as the plain BFS, whichever direction each step took
+TEST_CASE("Direction Optimizing BFS") {
+    SUBCASE("Undirected") {
+        Graph g(3000);
+        addRandomEdges(g, 30000, 7);
+        TraversalResult plain = Algorithms::bfs(g, 0);
+        TraversalResult fast = Algorithms::bfsDirectionOptimizing(g, 0);
+        CHECK(fast.orderSize == plain.orderSize);
+        for (int v = 0; v < 3000; v++) {
+            REQUIRE(fast.depth[v] == plain.depth[v]);
+            if (v != 0 && fast.reached(v)) {
+                CHECK(fast.depth[fast.parent[v]] == fast.depth[v] - 1);
+            }
+        }
+    }
+
+    SUBCASE("Directed with incoming lists") {
+        Graph g(2000);
+        addRandomEdges(g, 20000, 11, true);
+        CsrGraph out = g.freeze();
+        CsrGraph in = out.transpose();
+        TraversalResult plain = Algorithms::bfs(out, 0);
+        TraversalResult fast = Algorithms::bfsDirectionOptimizing(out, in, 0, 2, 2);
+        CHECK(fast.orderSize == plain.orderSize);
+        for (int v = 0; v < 2000; v++) {
+            REQUIRE(fast.depth[v] == plain.depth[v]);
+        }
+    }
+
+    SUBCASE("Directed Graph overload") {
+        Graph g(2000);
+        addRandomEdges(g, 20000, 11, true);
+        TraversalResult plain = Algorithms::bfs(g, 0);
+        TraversalResult fast = Algorithms::bfsDirectionOptimizing(g, 0, 2, 2);
+        CHECK(fast.orderSize == plain.orderSize);
+        for (int v = 0; v < 2000; v++) {
+            REQUIRE(fast.depth[v] == plain.depth[v]);
+        }
+    }
+}
+
+// parent choice may differ between runs, the levels may not
+TEST_CASE("Parallel BFS") {
+    Graph g(5000);
+    addRandomEdges(g, 40000, 3);
+    TraversalResult plain = Algorithms::bfs(g, 0);
+
+    for (int threads : {1, 4}) {
+        TraversalResult par = Algorithms::parallelBfs(g, 0, threads);
+        REQUIRE(par.orderSize == plain.orderSize);
+        int mismatches = 0;
+        for (int v = 0; v < 5000; v++) {
+            if (par.depth[v] != plain.depth[v]) mismatches++;
+            if (v != 0 && par.reached(v) && par.depth[par.parent[v]] != par.depth[v] - 1) mismatches++;
+        }
+        CHECK(mismatches == 0);
+        // order is level by level
+        for (int i = 1; i < par.orderSize; i++) {
+            REQUIRE(par.depth[par.order[i - 1]] <= par.depth[par.order[i]]);
+        }
+    }
+}
+
+// explicit stack DFS: deep graphs and timestamps
+TEST_CASE("Iterative DFS") {
+    SUBCASE("Long path does not overflow the call stack") {
+        const int n = 500000;
+        Graph path(n);
+        for (int i = 0; i + 1 < n; i++) path.addEdge(i, i + 1);
+        DfsResult r = Algorithms::dfs(path, 0);
+        CHECK(r.orderSize == n);
+        CHECK(r.depth[n - 1] == n - 1);
+        CHECK(r.postOrder[0] == n - 1);
+        CHECK(r.postOrder[n - 1] == 0);
+    }
+
+    SUBCASE("Timestamps and orders") {
+        Graph g(7);
+        g.addEdge(0, 1);
+        g.addEdge(0, 2);
+        g.addEdge(1, 3);
+        g.addEdge(1, 4);
+        g.addEdge(5, 6);
+
+        DfsResult r = Algorithms::dfs(g, 0);
+        int pre[] = {0, 1, 3, 4, 2};
+        int post[] = {3, 4, 1, 2, 0};
+        REQUIRE(r.orderSize == 5);
+        for (int i = 0; i < 5; i++) {
+            CHECK(r.preOrder()[i] == pre[i]);
+            CHECK(r.postOrder[i] == post[i]);
+        }
+        CHECK(r.discovery[0] == 0);
+        CHECK(r.finish[0] == 9);
+        // children nest inside their parent's interval
+        for (int v = 1; v < 5; v++) {
+            int p = r.parent[v];
+            CHECK(r.discovery[p] < r.discovery[v]);
+            CHECK(r.finish[v] < r.finish[p]);
+        }
+        CHECK(r.discovery[5] == -1);
+
+        DfsResult all = Algorithms::dfsForest(g);
+        CHECK(all.orderSize == 7);
+        CHECK(all.parent[6] == 5);
+        CHECK(all.finish[6] == 12);
+    }
+}
+
+// bucketed parallel SSSP must agree with Dijkstra
+TEST_CASE("Delta Stepping") {
+    Graph g(4000);
+    addRandomEdges(g, 30000, 5, false, 100);
+    ShortestPathResult expected = Algorithms::dijkstra(g, 0);
+
+    for (int threads : {1, 4}) {
+        for (int delta : {0, 1, 30, 1000}) {
+            ShortestPathResult r = Algorithms::deltaStepping(g, 0, delta, threads);
+            int mismatches = 0;
+            for (int v = 0; v < 4000; v++) {
+                if (r.dist[v] != expected.dist[v]) mismatches++;
+            }
+            CHECK(mismatches == 0);
+            CHECK(isShortestPathTree(g, r));
+        }
+    }
+
+    Graph negative(2);
+    negative.addEdge(0, 1, -1);
+    CHECK_THROWS_AS(Algorithms::deltaStepping(negative, 0), std::invalid_argument);
+}
+
+// bucket queue Dijkstra against the heap one
+TEST_CASE("Dial Bucket Queue") {
+    Graph g(3002);
+    addRandomEdges(g, 20000, 9, false, 1000);
+    // one heavy edge off to the side keeps dijkstra() on the heap
+    g.addEdge(3000, 3001, 1000000);
+
+    ShortestPathResult heap = Algorithms::dijkstra(g, 0);
+    ShortestPathResult buckets = Algorithms::dial(g, 0);
+    int mismatches = 0;
+    for (int v = 0; v < 3002; v++) {
+        if (heap.dist[v] != buckets.dist[v]) mismatches++;
+    }
+    CHECK(mismatches == 0);
+    CHECK(isShortestPathTree(g, buckets));
+
+    // zero weight edges are fine, negative ones are not
+    Graph h(3);
+    h.addEdge(0, 1, 0);
+    h.addEdge(1, 2, 3);
+    CHECK(Algorithms::dial(h, 0).dist[2] == 3);
+    h.addEdge(0, 2, -1);
+    CHECK_THROWS_AS(Algorithms::dial(h, 0), std::invalid_argument);
+
+    // the cached weight range follows edits and carries over to snapshots
+    CHECK(h.getMinWeight() == -1);
+    CHECK(h.getMaxWeight() == 3);
+    CHECK(h.freeze().transpose().getMinWeight() == -1);
+    h.removeEdge(0, 2);
+    CHECK(h.getMinWeight() == 0);
+    CHECK(h.getNumArcs() == 4);
+    CHECK(Algorithms::dial(h, 0).dist[2] == 3);
+    h.removeEdge(1, 2);
+    h.removeEdge(0, 1);
+    CHECK(h.getMinWeight() == 0);
+    CHECK(h.getMaxWeight() == 0);
+    CHECK(h.freeze().getMaxWeight() == 0);
+
+    // removals only mark the range stale, so emptying a graph whose edges
+    // all sit on the range stays linear
+    Graph equal(20001);
+    for (int v = 0; v < 20000; v++) equal.addEdge(v, v + 1, 7);
+    for (int v = 0; v < 19999; v++) equal.removeEdge(v, v + 1);
+    CHECK(equal.getMinWeight() == 7);
+    CHECK(equal.getMaxWeight() == 7);
+    equal.removeEdge(19999, 20000);
+    equal.addDirectedEdge(5, 6, 12);
+    CHECK(equal.getMinWeight() == 12);
+    CHECK(equal.getNumArcs() == 1);
+}
+
+// point to point queries agree with the full Dijkstra
+TEST_CASE("Bidirectional Shortest Path") {
+    Graph g(3000);
+    addRandomEdges(g, 12000, 21, false, 50);
+    CsrGraph csr = g.freeze();
+
+    for (int target : {0, 1, 17, 999, 2999}) {
+        ShortestPathResult full = Algorithms::dijkstra(csr, 5);
+        PathResult r = Algorithms::shortestPath(csr, 5, target);
+        CHECK(r.distance == full.dist[target]);
+        if (!full.reached(target)) {
+            CHECK_FALSE(r.found());
+            continue;
+        }
+        REQUIRE(r.found());
+        CHECK(r.path[0] == 5);
+        CHECK(r.path[r.length - 1] == target);
+        // the path really has that length
+        long long total = 0;
+        for (int i = 0; i + 1 < r.length; i++) {
+            int w = -1;
+            for (int j = 0; j < g.getNeighborCount(r.path[i]); j++) {
+                if (g.getNeighbors(r.path[i])[j].vertex == r.path[i + 1]) w = g.getNeighbors(r.path[i])[j].weight;
+            }
+            REQUIRE(w >= 0);
+            total += w;
+        }
+        CHECK(total == r.distance);
+    }
+
+    SUBCASE("Directed graph with a reverse") {
+        Graph d(4);
+        d.addDirectedEdge(0, 1, 1);
+        d.addDirectedEdge(1, 2, 1);
+        d.addDirectedEdge(2, 3, 1);
+        d.addDirectedEdge(3, 0, 1);
+        CsrGraph out = d.freeze();
+        CsrGraph in = out.transpose();
+        PathResult r = Algorithms::shortestPath(out, in, 1, 0);
+        CHECK(r.distance == 3);
+        CHECK(r.length == 4);
+        CHECK(Algorithms::shortestPath(out, in, 2, 2).distance == 0);
+    }
+
+    SUBCASE("Negative weights are rejected") {
+        Graph negative(3);
+        negative.addEdge(0, 1, 2);
+        negative.addEdge(1, 2, -1);
+        CHECK_THROWS_AS(Algorithms::shortestPath(negative, 0, 2), std::invalid_argument);
+    }
+}
+
+// A* and ALT return exact distances while settling fewer vertices
+TEST_CASE("A* And ALT") {
+    const int side = 60;
+    Graph grid(side * side);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            if (c + 1 < side) grid.addEdge(v, v + 1, 1 + (r * 7 + c * 3) % 5);
+            if (r + 1 < side) grid.addEdge(v, v + side, 1 + (r * 5 + c * 11) % 5);
+        }
+    }
+    CsrGraph csr = grid.freeze();
+    int source = 0;
+    int target = side * side - 1;
+    ShortestPathResult full = Algorithms::dijkstra(csr, source);
+
+    PathResult blind = Algorithms::aStar(csr, source, target, [](int) { return 0; });
+    CHECK(blind.distance == full.dist[target]);
+
+    // manhattan distance times the smallest weight is admissible
+    PathResult manhattan = Algorithms::aStar(csr, source, target, [&](int v) {
+        return (side - 1 - v / side) + (side - 1 - v % side);
+    });
+    CHECK(manhattan.distance == full.dist[target]);
+    CHECK(manhattan.settled <= blind.settled);
+
+    for (LandmarkSelection selection : {LandmarkSelection::Farthest, LandmarkSelection::Avoid}) {
+        LandmarkIndex index = Algorithms::buildLandmarks(csr, 6, selection);
+        CHECK(index.numLandmarks == 6);
+        for (int v : {target, 1234, 59, 3540}) {
+            PathResult alt = Algorithms::altShortestPath(csr, index, source, v);
+            CHECK(alt.distance == full.dist[v]);
+            CHECK(alt.path[alt.length - 1] == v);
+        }
+        CHECK(Algorithms::altShortestPath(csr, index, source, target).settled < blind.settled);
+    }
+
+    Graph negative(3);
+    negative.addEdge(0, 1, 2);
+    negative.addEdge(1, 2, -1);
+    CsrGraph bad = negative.freeze();
+    CHECK_THROWS_AS(Algorithms::aStar(bad, 0, 2, [](int) { return 0; }), std::invalid_argument);
+}
+
+// hierarchy queries, unpacked paths and a save/load round trip
+TEST_CASE("Contraction Hierarchies") {
+    // road like: a grid with a few long range links
+    const int side = 35;
+    const int n = side * side;
+    Graph g(n);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            if (c + 1 < side) g.addEdge(v, v + 1, 1 + (r * 7 + c * 3) % 9);
+            if (r + 1 < side) g.addEdge(v, v + side, 1 + (r * 5 + c * 11) % 9);
+        }
+    }
+    addRandomEdges(g, 40, 33, false, 40);
+    ContractionHierarchy ch = Algorithms::buildContractionHierarchy(g);
+    CHECK(ch.getNumVertices() == n);
+
+    ChQuery query(ch);
+    int checked = 0, wrong = 0;
+    for (int s : {0, 7, 444, n - 1}) {
+        ShortestPathResult full = Algorithms::dijkstra(g, s);
+        for (int t = 0; t < n; t += 13) {
+            PathResult r = query.shortestPath(s, t);
+            checked++;
+            if (r.distance != full.dist[t]) wrong++;
+            else if (r.found() && (r.path[0] != s || r.path[r.length - 1] != t || !isPathOfLength(g, r))) wrong++;
+        }
+    }
+    CHECK(checked > 100);
+    CHECK(wrong == 0);
+
+    const char* file = "ch_test_roundtrip.bin";
+    ch.save(file);
+    ContractionHierarchy loaded = ContractionHierarchy::load(file);
+    std::remove(file);
+    CHECK(loaded.getNumArcs() == ch.getNumArcs());
+    PathResult before = Algorithms::chShortestPath(ch, 3, 1200);
+    PathResult after = Algorithms::chShortestPath(loaded, 3, 1200);
+    CHECK(before.distance == after.distance);
+    CHECK(before.length == after.length);
+
+    CHECK_THROWS_AS(ContractionHierarchy::load("no_such_file.bin"), std::runtime_error);
+
+    // a shortcut 1-2 over 0 without the arcs of 0 loads, but cannot unpack
+    ContractionHierarchy broken(3, new int[3]{0, 1, 2}, new int[4]{0, 0, 1, 1}, new ChArc[1]{ChArc(2, 5, 0)});
+    broken.save(file);
+    ContractionHierarchy reloaded = ContractionHierarchy::load(file);
+    std::remove(file);
+    CHECK_THROWS_AS(Algorithms::chShortestPath(reloaded, 1, 2), std::runtime_error);
+
+    // repeated ranks, decreasing offsets and arcs going down are rejected
+    ContractionHierarchy repeated(3, new int[3]{0, 0, 2}, new int[4]{0, 0, 1, 1}, new ChArc[1]{ChArc(2, 5, -1)});
+    ContractionHierarchy decreasing(3, new int[3]{0, 1, 2}, new int[4]{0, 1, 0, 1}, new ChArc[1]{ChArc(2, 5, -1)});
+    ContractionHierarchy downward(3, new int[3]{0, 1, 2}, new int[4]{0, 0, 0, 1}, new ChArc[1]{ChArc(1, 5, -1)});
+    for (ContractionHierarchy* bad : {&repeated, &decreasing, &downward}) {
+        bad->save(file);
+        CHECK_THROWS_AS(ContractionHierarchy::load(file), std::runtime_error);
+        std::remove(file);
+    }
+}
+
+// every lane must match its own single source BFS
+TEST_CASE("Multi Source BFS") {
+    Graph g(2500);
+    addRandomEdges(g, 6000, 17);
+    int sources[70];
+    for (int i = 0; i < 70; i++) sources[i] = (i * 131) % 2500;
+    sources[69] = sources[3];   // duplicates are fine
+
+    MultiSourceDistances all = Algorithms::multiSourceBfs(g, sources, 70, 2);
+    CHECK(all.numSources == 70);
+    int mismatches = 0;
+    for (int i = 0; i < 70; i++) {
+        TraversalResult single = Algorithms::bfs(g, sources[i]);
+        for (int v = 0; v < 2500; v++) {
+            if (all.row(i)[v] != single.depth[v]) mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+
+    // one thread reuses its masks over several batches of a long directed
+    // path, where each batch only reaches the vertices after its sources
+    Graph chain(3000);
+    for (int v = 0; v + 1 < 3000; v++) chain.addDirectedEdge(v, v + 1);
+    int starts[200];
+    for (int i = 0; i < 200; i++) starts[i] = 2999 - i * 13;
+    MultiSourceDistances walks = Algorithms::multiSourceBfs(chain, starts, 200, 1);
+    int wrong = 0;
+    for (int i = 0; i < 200; i++) {
+        for (int v = 0; v < 3000; v++) {
+            int expected = v >= starts[i] ? v - starts[i] : -1;
+            if (walks.row(i)[v] != expected) wrong++;
+        }
+    }
+    CHECK(wrong == 0);
+}
+
+// same forest weight as Kruskal, ties and negative weights included
+TEST_CASE("Parallel Boruvka") {
+    Graph g(3000);
+    addRandomEdges(g, 9000, 41, false, 20);
+    // a separate component and a negative edge
+    Graph h(3005);
+    for (int v = 0; v < 3000; v++) {
+        for (int i = 0; i < g.getNeighborCount(v); i++) {
+            const Neighbor& e = g.getNeighbors(v)[i];
+            if (v < e.vertex) h.addEdge(v, e.vertex, e.weight);
+        }
+    }
+    h.addEdge(3000, 3001, -5);
+    h.addEdge(3001, 3002, 3);
+    h.addEdge(3002, 3000, 3);
+
+    SpanningForest expected = Algorithms::kruskal(h);
+    for (int threads : {1, 4}) {
+        SpanningForest forest = Algorithms::boruvka(h, threads);
+        CHECK(forest.edgeCount == expected.edgeCount);
+        CHECK(forest.totalWeight == expected.totalWeight);
+    }
+}
+
+// big enough to split and filter in parallel, plus a graph of equal weights
+TEST_CASE("Filter Kruskal") {
+    Graph g(20000);
+    addRandomEdges(g, 150000, 43, false, 1000);
+    g.addEdge(0, 1, -7);
+    Graph flat(5000);
+    addRandomEdges(flat, 20000, 44);
+
+    SpanningForest expected = Algorithms::kruskal(g);
+    SpanningForest expectedFlat = Algorithms::kruskal(flat);
+    for (int threads : {1, 4}) {
+        SpanningForest forest = Algorithms::filterKruskal(g, threads);
+        CHECK(forest.edgeCount == expected.edgeCount);
+        CHECK(forest.totalWeight == expected.totalWeight);
+
+        SpanningForest flatForest = Algorithms::filterKruskal(flat, threads);
+        CHECK(flatForest.edgeCount == expectedFlat.edgeCount);
+        CHECK(flatForest.totalWeight == expectedFlat.totalWeight);
+    }
+}
+
+// long chains and a hub that every thread links into at once
+TEST_CASE("Concurrent Union Find") {
+    Graph path(100000);
+    for (int v = 0; v + 1 < 100000; v++) {
+        path.addEdge(v, v + 1, (v * 7919) % 101);
+    }
+    // hub 0 joined to every other vertex, plus a heavy chain 1-2-...; built
+    // straight into CSR since Graph::addEdge scans the hub list every time
+    const int leaves = 50000;
+    int* offs = new int[leaves + 1];
+    Neighbor* list = new Neighbor[2 * (leaves - 1) + 2 * (leaves - 2)];
+    offs[0] = 0;
+    offs[1] = leaves - 1;
+    for (int v = 1; v < leaves; v++) {
+        offs[v + 1] = offs[v] + 1 + (v > 1) + (v + 1 < leaves);
+    }
+    for (int v = 1; v < leaves; v++) {
+        list[v - 1] = Neighbor(v, v % 5);
+        Neighbor* out = list + offs[v];
+        *out++ = Neighbor(0, v % 5);
+        if (v > 1) *out++ = Neighbor(v - 1, 10);
+        if (v + 1 < leaves) *out++ = Neighbor(v + 1, 10);
+    }
+    CsrGraph star(leaves, offs, list);
+
+    SpanningForest expectedPath = Algorithms::kruskal(path);
+    SpanningForest expectedStar = Algorithms::kruskal(star);
+    CHECK(expectedPath.edgeCount == 99999);
+    CHECK(expectedStar.edgeCount == leaves - 1);
+    for (int threads : {1, 4}) {
+        SpanningForest p = Algorithms::boruvka(path, threads);
+        CHECK(p.edgeCount == expectedPath.edgeCount);
+        CHECK(p.totalWeight == expectedPath.totalWeight);
+
+        SpanningForest s = Algorithms::boruvka(star, threads);
+        CHECK(s.edgeCount == expectedStar.edgeCount);
+        CHECK(s.totalWeight == expectedStar.totalWeight);
+    }
+}
+
+// labels agree with plain BFS, one giant component plus many small ones
+TEST_CASE("Connected Components") {
+    Graph g(30000);
+    addRandomEdges(g, 40000, 45);
+    for (int v = 25000; v + 1 < 30000; v += 3) {
+        g.addEdge(v, v + 1, 1);
+    }
+
+    for (int threads : {1, 4}) {
+        ComponentLabels labels = Algorithms::connectedComponents(g, threads);
+        int* expected = new int[30000];
+        for (int v = 0; v < 30000; v++) expected[v] = -1;
+        int count = 0;
+        for (int v = 0; v < 30000; v++) {
+            if (expected[v] != -1) continue;
+            TraversalResult r = Algorithms::bfs(g, v);
+            for (int i = 0; i < r.orderSize; i++) expected[r.order[i]] = count;
+            count++;
+        }
+        CHECK(labels.numComponents == count);
+        bool same = true;
+        for (int v = 0; v < 30000; v++) {
+            if (labels.component[v] != expected[v]) same = false;
+        }
+        CHECK(same);
+        delete[] expected;
+    }
+
+    Graph empty(5);
+    ComponentLabels alone = Algorithms::connectedComponents(empty);
+    CHECK(alone.numComponents == 5);
+    CHECK(!alone.connected(0, 1));
+}
+
+// both engines against mutual reachability, and the condensation is a DAG
+TEST_CASE("Strongly Connected Components") {
+    const int n = 300;
+    Graph small(n);
+    addRandomEdges(small, 420, 46, true);
+    bool* reach = new bool[n * n];
+    for (int u = 0; u < n; u++) {
+        TraversalResult r = Algorithms::bfs(small, u);
+        for (int v = 0; v < n; v++) reach[u * n + v] = r.reached(v);
+    }
+    for (SccEngine engine : {SccEngine::Tarjan, SccEngine::ForwardBackward}) {
+        SccResult scc = Algorithms::stronglyConnectedComponents(small, engine, 4);
+        bool same = true;
+        for (int u = 0; u < n; u++) {
+            for (int v = 0; v < n; v++) {
+                if (scc.connected(u, v) != (reach[u * n + v] && reach[v * n + u])) same = false;
+            }
+        }
+        CHECK(same);
+        CHECK(scc.condensation.getNumVertices() == scc.numComponents);
+        SccResult dag = Algorithms::stronglyConnectedComponents(scc.condensation);
+        CHECK(dag.numComponents == scc.numComponents);
+    }
+    delete[] reach;
+
+    // a large cycle with random chords and tails, engines must agree exactly
+    Graph big(20000);
+    for (int v = 0; v + 1 < 12000; v++) big.addDirectedEdge(v, v + 1, 1);
+    big.addDirectedEdge(11999, 0, 1);
+    addRandomEdges(big, 30000, 47, true);
+    SccResult tarjan = Algorithms::stronglyConnectedComponents(big, SccEngine::Tarjan);
+    for (int threads : {1, 4}) {
+        SccResult fb = Algorithms::stronglyConnectedComponents(big, SccEngine::ForwardBackward, threads);
+        CHECK(fb.numComponents == tarjan.numComponents);
+        bool same = true;
+        for (int v = 0; v < 20000; v++) {
+            if (fb.component[v] != tarjan.component[v]) same = false;
+        }
+        CHECK(same);
+        CHECK(fb.condensation.getNumArcs() == tarjan.condensation.getNumArcs());
+    }
+
+    // no giant component: 60 cycles of 400 with chords, joined only forward,
+    // so nearly everything is left to the recursive forward-backward tasks
+    const int blocks = 60, blockSize = 400;
+    Graph chainOfCycles(blocks * blockSize);
+    for (int b = 0; b < blocks; b++) {
+        int first = b * blockSize;
+        for (int i = 0; i < blockSize; i++) {
+            chainOfCycles.addDirectedEdge(first + i, first + (i + 1) % blockSize, 1);
+        }
+        for (int i = 0; i < blockSize; i += 7) {
+            chainOfCycles.addDirectedEdge(first + i, first + (i + 37 + i % 11) % blockSize, 1);
+        }
+        if (b + 1 < blocks) {
+            chainOfCycles.addDirectedEdge(first + 3, first + blockSize + 11, 1);
+            if (b + 2 < blocks) chainOfCycles.addDirectedEdge(first + 99, first + 2 * blockSize + 42, 1);
+        }
+    }
+    SccResult expected = Algorithms::stronglyConnectedComponents(chainOfCycles, SccEngine::Tarjan);
+    CHECK(expected.numComponents == blocks);
+    for (int threads : {1, 4}) {
+        SccResult fb = Algorithms::stronglyConnectedComponents(chainOfCycles, SccEngine::ForwardBackward, threads);
+        CHECK(fb.numComponents == blocks);
+        bool same = true;
+        for (int v = 0; v < blocks * blockSize; v++) {
+            if (fb.component[v] != expected.component[v]) same = false;
+        }
+        CHECK(same);
+    }
+}
+
+// bridges and cut vertices against removing them one at a time
+TEST_CASE("Bridges And Articulation Points") {
+    const int n = 120;
+    Graph g(n);
+    addRandomEdges(g, 150, 48);
+    BiconnectivityResult bc = Algorithms::biconnectivity(g);
+    int baseline = Algorithms::connectedComponents(g).numComponents;
+
+    bool* isBridge = new bool[n * n];
+    for (int i = 0; i < n * n; i++) isBridge[i] = false;
+    for (int i = 0; i < bc.bridgeCount; i++) {
+        isBridge[bc.bridges[i].u * n + bc.bridges[i].v] = true;
+        isBridge[bc.bridges[i].v * n + bc.bridges[i].u] = true;
+    }
+    bool bridgesMatch = true;
+    bool cutsMatch = true;
+    for (int u = 0; u < n; u++) {
+        for (int i = 0; i < g.getNeighborCount(u); i++) {
+            int v = g.getNeighbors(u)[i].vertex;
+            if (v < u) continue;
+            Graph without(n);
+            for (int x = 0; x < n; x++) {
+                for (int j = 0; j < g.getNeighborCount(x); j++) {
+                    int y = g.getNeighbors(x)[j].vertex;
+                    if (x < y && !(x == u && y == v)) without.addEdge(x, y);
+                }
+            }
+            bool splits = Algorithms::connectedComponents(without).numComponents > baseline;
+            if (splits != isBridge[u * n + v]) bridgesMatch = false;
+        }
+
+        // u left isolated counts as one extra component
+        Graph cut(n);
+        for (int x = 0; x < n; x++) {
+            for (int j = 0; j < g.getNeighborCount(x); j++) {
+                int y = g.getNeighbors(x)[j].vertex;
+                if (x < y && x != u && y != u) cut.addEdge(x, y);
+            }
+        }
+        int expected = baseline + (g.getNeighborCount(u) == 0 ? 0 : 1);
+        bool splits = Algorithms::connectedComponents(cut).numComponents > expected;
+        if (splits != bc.articulation[u]) cutsMatch = false;
+    }
+    CHECK(bridgesMatch);
+    CHECK(cutsMatch);
+    delete[] isBridge;
+
+    // both directions share a label, and a bridge is a component of its own
+    CsrGraph csr = g.freeze();
+    int* edgesIn = new int[bc.numComponents];
+    for (int c = 0; c < bc.numComponents; c++) edgesIn[c] = 0;
+    bool labeled = true;
+    for (int a = 0; a < csr.getNumArcs(); a++) {
+        if (bc.arcComponent[a] < 0) labeled = false;
+        else edgesIn[bc.arcComponent[a]]++;
+    }
+    CHECK(labeled);
+    int singleEdge = 0;
+    for (int c = 0; c < bc.numComponents; c++) {
+        if (edgesIn[c] == 2) singleEdge++;
+    }
+    CHECK(singleEdge >= bc.bridgeCount);
+    delete[] edgesIn;
+
+    // deep path: every edge a bridge, every inner vertex a cut vertex
+    Graph path(100000);
+    for (int v = 0; v + 1 < 100000; v++) path.addEdge(v, v + 1);
+    BiconnectivityResult chain = Algorithms::biconnectivity(path);
+    CHECK(chain.bridgeCount == 99999);
+    CHECK(chain.numComponents == 99999);
+    int cuts = 0;
+    for (int v = 0; v < 100000; v++) cuts += chain.articulation[v] ? 1 : 0;
+    CHECK(cuts == 99998);
+}
+
+// matches a plain power iteration, dangling vertices included
+TEST_CASE("PageRank") {
+    const int n = 400;
+    Graph g(n);
+    addRandomEdges(g, 1500, 49, true);
+    const double d = 0.85;
+
+    double* expected = new double[n];
+    double* next = new double[n];
+    for (int v = 0; v < n; v++) expected[v] = 1.0 / n;
+    for (int iter = 0; iter < 300; iter++) {
+        double lost = 0;
+        for (int v = 0; v < n; v++) {
+            next[v] = 0;
+            if (g.getNeighborCount(v) == 0) lost += expected[v];
+        }
+        for (int u = 0; u < n; u++) {
+            for (int i = 0; i < g.getNeighborCount(u); i++) {
+                next[g.getNeighbors(u)[i].vertex] += d * expected[u] / g.getNeighborCount(u);
+            }
+        }
+        for (int v = 0; v < n; v++) expected[v] = next[v] + (1 - d) / n + d * lost / n;
+    }
+
+    for (int threads : {1, 4}) {
+        PageRankResult pr = Algorithms::pageRank(g, d, 1e-12, 300, threads);
+        CHECK(pr.converged);
+        CHECK(pr.iterations < 300);
+        double total = 0;
+        double worst = 0;
+        for (int v = 0; v < n; v++) {
+            total += pr.rank[v];
+            double diff = pr.rank[v] - expected[v];
+            if (diff < 0) diff = -diff;
+            if (diff > worst) worst = diff;
+        }
+        CHECK(total == doctest::Approx(1.0));
+        CHECK(worst < 1e-10);
+        CHECK(pr.iterationSeconds[0] >= 0);
+    }
+    delete[] expected;
+    delete[] next;
+
+    // every vertex of a cycle is alike
+    Graph ring(10);
+    for (int v = 0; v < 10; v++) ring.addEdge(v, (v + 1) % 10);
+    PageRankResult flat = Algorithms::pageRank(ring);
+    CHECK(flat.rank[3] == doctest::Approx(0.1));
+    CHECK_THROWS_AS(Algorithms::pageRank(ring, 1.0), std::invalid_argument);
+
+    PageRankResult capped = Algorithms::pageRank(g, d, 0.0, 5, 2);
+    CHECK(!capped.converged);
+    CHECK(capped.iterations == 5);
+}
+
+// push estimates never overshoot, the missing mass is exactly the residual
+// left behind, and on undirected graphs every score is within eps * degree
+TEST_CASE("Personalized PageRank") {
+    const int n = 300;
+    Graph directed(n);
+    addRandomEdges(directed, 900, 50, true);
+    Graph undirected(n);
+    addRandomEdges(undirected, 700, 51);
+    const double alpha = 0.15;
+    const double eps = 1e-7;
+
+    PprWorkspace ws(n);
+    double* exact = new double[n];
+    double* next = new double[n];
+    for (const Graph* g : {&directed, &undirected}) {
+        for (int seed : {0, 17, 123}) {
+            for (int v = 0; v < n; v++) exact[v] = v == seed ? 1.0 : 0.0;
+            for (int iter = 0; iter < 400; iter++) {
+                for (int v = 0; v < n; v++) next[v] = 0;
+                next[seed] += alpha;
+                for (int u = 0; u < n; u++) {
+                    int degree = g->getNeighborCount(u);
+                    if (degree == 0) {
+                        next[seed] += (1 - alpha) * exact[u];
+                        continue;
+                    }
+                    for (int i = 0; i < degree; i++) {
+                        next[g->getNeighbors(u)[i].vertex] += (1 - alpha) * exact[u] / degree;
+                    }
+                }
+                for (int v = 0; v < n; v++) exact[v] = next[v];
+            }
+
+            // the same workspace serves every query
+            Algorithms::personalizedPageRank(*g, seed, ws, alpha, eps);
+            bool below = true;
+            bool close = true;
+            double missing = 0;
+            double left = 0;
+            for (int v = 0; v < n; v++) {
+                int degree = g->getNeighborCount(v) > 0 ? g->getNeighborCount(v) : 1;
+                double diff = exact[v] - ws.estimate[v];
+                if (diff < -1e-12) below = false;
+                if (diff > eps * degree + 1e-12) close = false;
+                missing += diff;
+                left += ws.residual[v];
+            }
+            CHECK(below);
+            CHECK(missing == doctest::Approx(left).epsilon(1e-6));
+            if (g == &undirected) CHECK(close);
+        }
+    }
+    delete[] exact;
+    delete[] next;
+
+    // on a long path only the seed's neighborhood is touched
+    Graph path(100000);
+    for (int v = 0; v + 1 < 100000; v++) path.addEdge(v, v + 1);
+    CsrGraph csr = path.freeze();
+    PprWorkspace local(100000);
+    Algorithms::personalizedPageRank(csr, 50000, local, 0.2, 1e-4);
+    CHECK(local.touchedCount > 1);
+    CHECK(local.touchedCount < 200);
+    CHECK(local.estimate[50000] > local.estimate[50010]);
+    CHECK_THROWS_AS(Algorithms::personalizedPageRank(directed, 0, local), std::invalid_argument);
+}
+
+// exact scores from pairwise path counts, sampled scores within their bound
+static void brandesByPairs(const Graph& g, double* expected) {
+    int n = g.getNumVertices();
+    long long* dist = new long long[n * n];
+    double* paths = new double[n * n];
+    int* byDist = new int[n];
+    for (int s = 0; s < n; s++) {
+        ShortestPathResult r = Algorithms::dijkstra(g, s);
+        for (int v = 0; v < n; v++) {
+            dist[s * n + v] = r.dist[v] == INT_MAX ? -1 : r.dist[v];
+            byDist[v] = v;
+        }
+        // count paths in order of distance, weights are positive
+        for (int i = 1; i < n; i++) {
+            for (int j = i; j > 0 && r.dist[byDist[j]] < r.dist[byDist[j - 1]]; j--) {
+                int tmp = byDist[j];
+                byDist[j] = byDist[j - 1];
+                byDist[j - 1] = tmp;
+            }
+        }
+        for (int v = 0; v < n; v++) paths[s * n + v] = v == s ? 1 : 0;
+        for (int i = 0; i < n; i++) {
+            int u = byDist[i];
+            if (r.dist[u] == INT_MAX) continue;
+            for (int k = 0; k < g.getNeighborCount(u); k++) {
+                const Neighbor& e = g.getNeighbors(u)[k];
+                if (r.dist[u] + e.weight == r.dist[e.vertex]) paths[s * n + e.vertex] += paths[s * n + u];
+            }
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        expected[v] = 0;
+        for (int s = 0; s < n; s++) {
+            for (int t = 0; t < n; t++) {
+                if (s == v || t == v || s == t) continue;
+                long long sv = dist[s * n + v], vt = dist[v * n + t], st = dist[s * n + t];
+                if (sv < 0 || vt < 0 || sv + vt != st) continue;
+                expected[v] += paths[s * n + v] * paths[v * n + t] / paths[s * n + t];
+            }
+        }
+    }
+    delete[] dist;
+    delete[] paths;
+    delete[] byDist;
+}
+
+TEST_CASE("Betweenness Centrality") {
+    const int n = 70;
+    for (int maxWeight : {1, 4}) {
+        Graph g(n);
+        addRandomEdges(g, 140, 52, false, maxWeight);
+        g.addDirectedEdge(3, 60, 1);
+        double* expected = new double[n];
+        brandesByPairs(g, expected);
+        for (int threads : {1, 4}) {
+            BetweennessResult bc = Algorithms::betweenness(g, 0, threads);
+            CHECK(bc.sourcesUsed == n);
+            CHECK(bc.errorBound == 0);
+            bool same = true;
+            for (int v = 0; v < n; v++) {
+                if (bc.score[v] != doctest::Approx(expected[v]).epsilon(1e-9)) same = false;
+            }
+            CHECK(same);
+        }
+        delete[] expected;
+    }
+
+    Graph big(2000);
+    addRandomEdges(big, 5000, 53);
+    BetweennessResult exact = Algorithms::betweenness(big, 0, 4);
+    BetweennessResult sampled = Algorithms::betweenness(big, 400, 4);
+    CHECK(sampled.sourcesUsed == 400);
+    CHECK(sampled.errorBound > 0);
+    bool within = true;
+    for (int v = 0; v < 2000; v++) {
+        double diff = sampled.score[v] - exact.score[v];
+        if (diff < -sampled.errorBound || diff > sampled.errorBound) within = false;
+    }
+    CHECK(within);
+
+    Graph negative(3);
+    negative.addEdge(0, 1, 2);
+    negative.addEdge(1, 2, -1);
+    CHECK_THROWS_AS(Algorithms::betweenness(negative), std::invalid_argument);
+}
+
+// counts against an adjacency matrix, a clique, and a hub with skewed lists
+TEST_CASE("Triangle Counting") {
+    const int n = 150;
+    Graph g(n);
+    addRandomEdges(g, 1200, 54);
+    for (int v = 1; v < n; v += 2) {
+        try {
+            g.addEdge(0, v);
+        } catch (const std::invalid_argument&) {
+        }
+    }
+    bool* adjacent = new bool[n * n];
+    for (int i = 0; i < n * n; i++) adjacent[i] = false;
+    for (int u = 0; u < n; u++) {
+        for (int i = 0; i < g.getNeighborCount(u); i++) adjacent[u * n + g.getNeighbors(u)[i].vertex] = true;
+    }
+    long long expectedTotal = 0;
+    long long* expected = new long long[n];
+    for (int v = 0; v < n; v++) expected[v] = 0;
+    for (int a = 0; a < n; a++) {
+        for (int b = a + 1; b < n; b++) {
+            if (!adjacent[a * n + b]) continue;
+            for (int c = b + 1; c < n; c++) {
+                if (adjacent[a * n + c] && adjacent[b * n + c]) {
+                    expectedTotal++;
+                    expected[a]++;
+                    expected[b]++;
+                    expected[c]++;
+                }
+            }
+        }
+    }
+    for (int threads : {1, 4}) {
+        TriangleResult tri = Algorithms::countTriangles(g, threads);
+        CHECK(tri.total == expectedTotal);
+        bool same = true;
+        for (int v = 0; v < n; v++) {
+            if (tri.perVertex[v] != expected[v]) same = false;
+        }
+        CHECK(same);
+        long long degree = g.getNeighborCount(0);
+        CHECK(tri.clustering[0] == doctest::Approx(2.0 * expected[0] / (degree * (degree - 1))));
+    }
+    delete[] adjacent;
+    delete[] expected;
+
+    Graph clique(30);
+    for (int u = 0; u < 30; u++) {
+        for (int v = u + 1; v < 30; v++) clique.addEdge(u, v);
+    }
+    TriangleResult full = Algorithms::countTriangles(clique, 4);
+    CHECK(full.total == 30 * 29 * 28 / 6);
+    CHECK(full.perVertex[7] == 29 * 28 / 2);
+    CHECK(full.clustering[7] == doctest::Approx(1.0));
+
+    // the intersection kernels directly, including the galloping path
+    int small[] = {3, 40, 41, 500, 999};
+    int* large = new int[1000];
+    for (int i = 0; i < 1000; i++) large[i] = i;
+    int hits = 0;
+    simd::intersect(small, 5, large, 1000, [&](int) { hits++; });
+    CHECK(hits == 5);
+    int odd[] = {1, 3, 5, 7, 9, 11, 13, 15, 17};
+    int mixed[] = {2, 3, 4, 5, 8, 9, 10, 17, 20};
+    hits = 0;
+    simd::intersect(odd, 9, mixed, 9, [&](int) { hits++; });
+    CHECK(hits == 4);
+    delete[] large;
+}
+
+// core numbers against repeatedly deleting low degree vertices
+TEST_CASE("Core Numbers") {
+    const int n = 400;
+    Graph g(n);
+    addRandomEdges(g, 2400, 55);
+    for (int u = 380; u < 400; u++) {
+        for (int v = u + 1; v < 400; v++) {
+            try {
+                g.addEdge(u, v);
+            } catch (const std::invalid_argument&) {
+            }
+        }
+    }
+
+    // expected[v] = largest k whose k-core still holds v
+    int* expected = new int[n];
+    int* degree = new int[n];
+    bool* alive = new bool[n];
+    for (int v = 0; v < n; v++) expected[v] = 0;
+    for (int k = 1; k < n; k++) {
+        for (int v = 0; v < n; v++) {
+            alive[v] = true;
+            degree[v] = g.getNeighborCount(v);
+        }
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int v = 0; v < n; v++) {
+                if (!alive[v] || degree[v] >= k) continue;
+                alive[v] = false;
+                changed = true;
+                for (int i = 0; i < g.getNeighborCount(v); i++) degree[g.getNeighbors(v)[i].vertex]--;
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            if (alive[v]) expected[v] = k;
+        }
+    }
+
+    for (CoreEngine engine : {CoreEngine::Bucket, CoreEngine::ParallelPeel}) {
+        for (int threads : {1, 4}) {
+            CoreResult cores = Algorithms::coreNumbers(g, engine, threads);
+            bool same = true;
+            int top = 0;
+            for (int v = 0; v < n; v++) {
+                if (cores.core[v] != expected[v]) same = false;
+                if (expected[v] > top) top = expected[v];
+            }
+            CHECK(same);
+            CHECK(cores.maxCore == top);
+            CHECK(cores.core[399] >= 19);
+        }
+    }
+    delete[] expected;
+    delete[] degree;
+    delete[] alive;
+
+    // both engines agree on a bigger graph with isolated vertices
+    Graph big(30000);
+    addRandomEdges(big, 120000, 56);
+    CoreResult bucket = Algorithms::coreNumbers(big, CoreEngine::Bucket);
+    CoreResult peel = Algorithms::coreNumbers(big, CoreEngine::ParallelPeel, 4);
+    bool agree = bucket.maxCore == peel.maxCore;
+    for (int v = 0; v < 30000; v++) {
+        if (bucket.core[v] != peel.core[v]) agree = false;
+    }
+    CHECK(agree);
+}
+
+// planted cliques with a few links between them come back as communities
+TEST_CASE("Louvain Communities") {
+    const int groups = 8, groupSize = 20, n = groups * groupSize;
+    Graph g(n);
+    for (int c = 0; c < groups; c++) {
+        for (int i = 0; i < groupSize; i++) {
+            for (int j = i + 1; j < groupSize; j++) g.addEdge(c * groupSize + i, c * groupSize + j, 2);
+        }
+        int next = (c + 1) % groups;
+        g.addEdge(c * groupSize, next * groupSize + 1, 1);
+        g.addEdge(c * groupSize + 5, next * groupSize + 7, 1);
+    }
+
+    for (int threads : {1, 4}) {
+        CommunityResult found = Algorithms::louvain(g, threads);
+        CHECK(found.numCommunities == groups);
+        CHECK(found.levels >= 1);
+        bool planted = true;
+        for (int v = 0; v < n; v++) {
+            if (found.community[v] != found.community[(v / groupSize) * groupSize]) planted = false;
+            if (found.community[v] < 0 || found.community[v] >= found.numCommunities) planted = false;
+        }
+        CHECK(planted);
+
+        // modularity recomputed by hand
+        double twiceM = 0, inside = 0;
+        double* total = new double[found.numCommunities];
+        for (int c = 0; c < found.numCommunities; c++) total[c] = 0;
+        for (int u = 0; u < n; u++) {
+            for (int i = 0; i < g.getNeighborCount(u); i++) {
+                const Neighbor& e = g.getNeighbors(u)[i];
+                twiceM += e.weight;
+                total[found.community[u]] += e.weight;
+                if (found.community[u] == found.community[e.vertex]) inside += e.weight;
+            }
+        }
+        double q = inside / twiceM;
+        for (int c = 0; c < found.numCommunities; c++) q -= (total[c] / twiceM) * (total[c] / twiceM);
+        CHECK(found.modularity == doctest::Approx(q));
+        CHECK(found.modularity > 0.8);
+        delete[] total;
+    }
+
+    // the same groups with one-way arcs: u and v are joined by the sum of
+    // both directions, so the planted split and its modularity come back
+    Graph directed(n);
+    for (int c = 0; c < groups; c++) {
+        for (int i = 0; i < groupSize; i++) {
+            for (int j = i + 1; j < groupSize; j++) directed.addDirectedEdge(c * groupSize + j, c * groupSize + i, 2);
+        }
+        int next = (c + 1) % groups;
+        directed.addDirectedEdge(c * groupSize, next * groupSize + 1, 1);
+        directed.addDirectedEdge(next * groupSize + 7, c * groupSize + 5, 1);
+    }
+    CommunityResult undirectedFound = Algorithms::louvain(g, 1);
+    CommunityResult directedFound = Algorithms::louvain(directed, 1);
+    CHECK(directedFound.numCommunities == groups);
+    bool plantedDirected = true;
+    for (int v = 0; v < n; v++) {
+        if (directedFound.community[v] != directedFound.community[(v / groupSize) * groupSize]) plantedDirected = false;
+    }
+    CHECK(plantedDirected);
+    CHECK(directedFound.modularity == doctest::Approx(undirectedFound.modularity));
+
+    // a bigger sparse graph goes through several levels
+    Graph big(5000);
+    addRandomEdges(big, 15000, 57, false, 3);
+    CommunityResult many = Algorithms::louvain(big, 4);
+    CHECK(many.levels >= 2);
+    CHECK(many.modularity > 0.3);
+
+    Graph empty(4);
+    CommunityResult alone = Algorithms::louvain(empty);
+    CHECK(alone.numCommunities == 4);
+    CHECK(alone.modularity == 0);
+    Graph negative(2);
+    negative.addEdge(0, 1, -1);
+    CHECK_THROWS_AS(Algorithms::louvain(negative), std::invalid_argument);
+}